@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+
 /**
  * @file main.c
  * @brief Main entry point for the KumoTrail kernel.
@@ -23,16 +24,32 @@
 #include "timer.h"
 #include "trap.h"
 #include "sysctl.h"
+#include "kernel.h"
+#include "scheduler.h"
+
+/** Stack size of the tick report task in bytes. */
+#define TICK_REPORT_STACK_SIZE 1024
+
+static void tick_report_task(void);
+
+TASK_DEFINE(tick_report_tcb, tick_report_task, KERNEL_DEFAULT_PRIORITY, TICK_REPORT_STACK_SIZE);
 
 /**
- * @brief The kernel's tick handler.
+ * @brief Prints "Tick!" once per second.
  *
- * This function is registered as a callback and is executed by the timer
- * driver on every timer interrupt.
+ * task_delay_until() keeps the cadence exact and lets the kernel stay
+ * tickless in between, which a print from the timer callback would not:
+ * the callback does not run for suppressed ticks.
  */
-void kernel_tick_handler(void)
+static void tick_report_task(void)
 {
-    uart_puts("Tick!\n");
+    uint32_t wake_tick = scheduler_get_ticks();
+
+    while (1)
+    {
+        task_delay_until(&wake_tick, KERNEL_TICK_HZ);
+        uart_write("Tick!\n", 6);
+    }
 }
 
 /**
@@ -44,19 +61,17 @@ void main(void)
     uart_init();
     timer_init();
     trap_init();
+    scheduler_init();
 
-    // Register our tick handler function with the timer driver.
-    timer_set_callback(kernel_tick_handler);
+    // The timer interrupt drives the scheduler tick.
+    timer_set_callback(scheduler_tick);
 
     // Enable interrupts globally. The system is now live.
     enable_interrupts();
 
     uart_puts("KumoTrail has booted. Interrupts are enabled.\n");
 
-    // The CPU will now idle here. The timer interrupt will periodically
-    // call our handler and print "Tick!".
-    while (1)
-    {
-        // This is the idle loop.
-    }
+    // Hand the CPU to the scheduler. The tick report task prints "Tick!"
+    // every second and the idle task sleeps tickless in between.
+    scheduler_start();
 }
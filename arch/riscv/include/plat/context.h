@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file context.h
+ * @brief Layout of the register frame saved by the RISC-V trap entry code.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Register xN lives at word N of the frame. The two slots that would hold
+ * x0 and x2 (sp) carry mepc and mstatus instead, since zero is never saved
+ * and sp is kept in the task's TCB. This layout must match the FRAME_*
+ * offsets in arch/riscv/trap.S.
+ */
+
+#ifndef KUMOTRAIL_CONTEXT_H
+#define KUMOTRAIL_CONTEXT_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t mepc;      /* x0 slot */
+    uint32_t ra;
+    uint32_t mstatus;   /* x2 (sp) slot */
+    uint32_t gp;
+    uint32_t tp;
+    uint32_t t0;
+    uint32_t t1;
+    uint32_t t2;
+    uint32_t s0;
+    uint32_t s1;
+    uint32_t a0;
+    uint32_t a1;
+    uint32_t a2;
+    uint32_t a3;
+    uint32_t a4;
+    uint32_t a5;
+    uint32_t a6;
+    uint32_t a7;
+    uint32_t s2;
+    uint32_t s3;
+    uint32_t s4;
+    uint32_t s5;
+    uint32_t s6;
+    uint32_t s7;
+    uint32_t s8;
+    uint32_t s9;
+    uint32_t s10;
+    uint32_t s11;
+    uint32_t t3;
+    uint32_t t4;
+    uint32_t t5;
+    uint32_t t6;
+} trap_frame_t;
+
+#endif /* KUMOTRAIL_CONTEXT_H */
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file csr.h
+ * @brief RISC-V control and status register access helpers.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * All macros take the CSR by name (e.g. mstatus) so the address is resolved
+ * by the assembler at compile time.
+ */
+
+#ifndef KUMOTRAIL_CSR_H
+#define KUMOTRAIL_CSR_H
+
+#include <stdint.h>
+
+/* mstatus bit definitions */
+#define MSTATUS_MIE     (1U << 3)
+#define MSTATUS_MPIE    (1U << 7)
+#define MSTATUS_MPP_M   (3U << 11)
+
+/* CSR write macro - requires compile-time constant CSR address */
+#define write_csr(csr, value) \
+({ \
+    uint32_t __v = (uint32_t)(value); \
+    asm volatile ("csrw " #csr ", %0" \
+                  : : "r"(__v) \
+                  : "memory"); \
+})
+
+/* CSR read macro - requires compile-time constant CSR address */
+#define read_csr(csr) \
+({ \
+    uint32_t __v; \
+    asm volatile ("csrr %0, " #csr \
+                  : "=r"(__v) : : "memory"); \
+    __v; \
+})
+
+/* Read a 64-bit counter CSR pair (e.g. mcycle/mcycleh) on RV32. The high
+ * half is read on both sides of the low half and the read is retried if
+ * the low half carried in between. */
+#define read_csr64(csr) \
+({ \
+    uint32_t __hi, __lo, __hi2; \
+    do { \
+        __hi = read_csr(csr##h); \
+        __lo = read_csr(csr); \
+        __hi2 = read_csr(csr##h); \
+    } while (__hi != __hi2); \
+    ((uint64_t)__hi << 32) | __lo; \
+})
+
+/* Atomically set bits in a CSR and return its previous value (csrrs/csrrsi) */
+#define set_csr(csr, bits) \
+({ \
+    uint32_t __v; \
+    asm volatile ("csrrs %0, " #csr ", %1" \
+                  : "=r"(__v) : "rK"((uint32_t)(bits)) \
+                  : "memory"); \
+    __v; \
+})
+
+/* Atomically clear bits in a CSR and return its previous value (csrrc/csrrci) */
+#define clear_csr(csr, bits) \
+({ \
+    uint32_t __v; \
+    asm volatile ("csrrc %0, " #csr ", %1" \
+                  : "=r"(__v) : "rK"((uint32_t)(bits)) \
+                  : "memory"); \
+    __v; \
+})
+
+#endif /* KUMOTRAIL_CSR_H */
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file irq.h
+ * @brief Nesting critical sections on the global interrupt enable.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Each operation is a single csrrci or csrrs on mstatus, so no trap can
+ * land between reading and writing MIE. irq_save() returns only the MIE
+ * bit; restoring a state saved with interrupts already masked is a no-op,
+ * which is what lets sections nest:
+ *
+ *     uint32_t irq = irq_save();
+ *     ...
+ *     irq_restore(irq);
+ *
+ * To keep a task from being preempted without masking interrupts, use
+ * scheduler_lock() instead.
+ */
+
+#ifndef KUMOTRAIL_IRQ_H
+#define KUMOTRAIL_IRQ_H
+
+#include <stdint.h>
+#include "csr.h"
+
+/**
+ * @brief Masks interrupts and returns the previous interrupt-enable state.
+ */
+static inline uint32_t irq_save(void)
+{
+    return clear_csr(mstatus, MSTATUS_MIE) & MSTATUS_MIE;
+}
+
+/**
+ * @brief Re-enables interrupts if they were enabled at the matching
+ * irq_save().
+ */
+static inline void irq_restore(uint32_t state)
+{
+    set_csr(mstatus, state);
+}
+
+/**
+ * @brief Masks interrupts unconditionally.
+ */
+static inline void irq_disable(void)
+{
+    clear_csr(mstatus, MSTATUS_MIE);
+}
+
+/**
+ * @brief Enables interrupts unconditionally.
+ */
+static inline void irq_enable(void)
+{
+    set_csr(mstatus, MSTATUS_MIE);
+}
+
+#endif /* KUMOTRAIL_IRQ_H */
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file context_switch.c
+ * @brief mcycle benchmark of the preemptive context switch (make bench).
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Two tasks of equal priority spin, each stamping mcycle into a shared
+ * variable together with its own id. When a task sees a stamp written by
+ * the other task, the CPU was handed over by a tick preemption since that
+ * stamp, and the cycle delta is the full cost of the switch: trap entry,
+ * tick handler, scheduler_switch() and the restore of the other task.
+ */
+
+#include "uart.h"
+#include "timer.h"
+#include "trap.h"
+#include "scheduler.h"
+#include "csr.h"
+#include <stdint.h>
+
+#define BENCH_SAMPLES 64
+
+static volatile uint32_t last_stamp;
+static volatile uint32_t last_owner;
+
+static volatile uint32_t sample_count;
+static uint32_t sample_min = 0xFFFFFFFFU;
+static uint32_t sample_max;
+static uint32_t sample_sum;
+
+static void bench_print_u32(uint32_t value)
+{
+    char buf[11];
+    int i = sizeof(buf) - 1;
+
+    buf[i] = '\0';
+    do {
+        buf[--i] = (char)('0' + value % 10U);
+        value /= 10U;
+    } while (value);
+    uart_puts(&buf[i]);
+}
+
+static void bench_report(void)
+{
+    uart_puts("context switch (cycles): min ");
+    bench_print_u32(sample_min);
+    uart_puts(" avg ");
+    bench_print_u32(sample_sum / BENCH_SAMPLES);
+    uart_puts(" max ");
+    bench_print_u32(sample_max);
+    uart_puts(" over ");
+    bench_print_u32(BENCH_SAMPLES);
+    uart_puts(" switches\n");
+}
+
+static void bench_spin(uint32_t self)
+{
+    while (sample_count < BENCH_SAMPLES)
+    {
+        uint32_t now = read_csr(mcycle);
+
+        if (last_owner != self && last_owner != 0) {
+            uint32_t delta = now - last_stamp;
+
+            if (delta < sample_min) {
+                sample_min = delta;
+            }
+            if (delta > sample_max) {
+                sample_max = delta;
+            }
+            sample_sum += delta;
+            sample_count++;
+        }
+        last_stamp = read_csr(mcycle);
+        last_owner = self;
+    }
+
+    if (self == 1) {
+        bench_report();
+    }
+    while (1)
+    {
+    }
+}
+
+static void bench_task_a(void)
+{
+    bench_spin(1);
+}
+
+static void bench_task_b(void)
+{
+    bench_spin(2);
+}
+
+void main(void)
+{
+    uart_init();
+    timer_init();
+    trap_init();
+    scheduler_init();
+
+    timer_set_callback(scheduler_tick);
+
+    task_create(bench_task_a);
+    task_create(bench_task_b);
+
+    uart_puts("KumoTrail context switch benchmark\n");
+    scheduler_start();
+}
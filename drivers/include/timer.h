@@ -24,6 +24,18 @@
 #ifndef TIMER_H
 #define TIMER_H
 
+#include <stdint.h>
+
+/**
+ * @brief Frequency of the monotonic timebase in Hz.
+ *
+ * TIMG1_T0 divides the 80 MHz APB clock by 5, giving 62.5 ns resolution.
+ * Kept a power-of-two multiple of 1 MHz so conversions are shifts; the
+ * kernel is linked without libgcc and has no 64-bit division.
+ */
+#define TIMER_TIMEBASE_HZ       16000000U
+#define TIMER_TIMEBASE_US_SHIFT 4
+
 /*
 * @brief This function will initialize the peripheral to use the TIMER GROUP (TIMG)
 * for an interrupt signal generation. 
@@ -32,15 +44,74 @@
 void timer_init(void);
 
 /**
- * @brief Handles timer interrupts.
+ * @brief Handles timer interrupts. Registered for INTERRUPT_LINE_TIMER.
+ * @param arg Unused.
  */
-void timer_handle_interrupt(void);
+void timer_handle_interrupt(void *arg);
 
 /**
- * @brief Sets a callback function to be executed on each timer tick.
+ * @brief Sets a callback function to be executed on each timer interrupt.
+ *
+ * The callback runs once per tick alarm the hardware delivers. Ticks that
+ * pass while the tick is suppressed by timer_suppress_ticks() do not call
+ * it; the idle task accounts for them through scheduler_step_ticks(). Work
+ * that must happen at a fixed rate belongs in a software timer or a task
+ * using task_delay_until(), not in this callback.
+ *
  * @param callback The function pointer to the callback.
  */
 void timer_set_callback(void (*callback)(void));
 
+/**
+ * @brief Stops the periodic tick and arms one wakeup alarm (tickless idle).
+ * @param ticks Whole ticks from the last tick boundary to the wakeup.
+ * @return 0 on success, -1 if a tick is already pending.
+ */
+int timer_suppress_ticks(uint32_t ticks);
+
+/**
+ * @brief Restarts the periodic tick after timer_suppress_ticks().
+ * @return Number of whole ticks that elapsed while suppressed.
+ */
+uint32_t timer_resume_ticks(void);
+
+/**
+ * @brief Reads the free-running 64-bit timebase (latched, never torn).
+ * @return Counts of TIMER_TIMEBASE_HZ since timer_init().
+ */
+uint64_t timer_now_ticks64(void);
+
+/**
+ * @brief Reads the monotonic clock.
+ * @return Microseconds since timer_init().
+ */
+uint64_t timer_now_us(void);
+
+/**
+ * @brief Converts timebase counts to microseconds.
+ */
+static inline uint64_t timer_ticks64_to_us(uint64_t ticks)
+{
+    return ticks >> TIMER_TIMEBASE_US_SHIFT;
+}
+
+/**
+ * @brief Wrap-safe check that time a is before time b.
+ *
+ * For 32-bit counters that wrap, such as kernel ticks or the low word of
+ * timer_now_us(). Valid while the two values are less than 2^31 apart.
+ */
+static inline int timer_before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+/**
+ * @brief Wrap-safe check that time a is after time b.
+ */
+static inline int timer_after(uint32_t a, uint32_t b)
+{
+    return (int32_t)(b - a) < 0;
+}
 
 #endif
@@ -30,7 +30,7 @@
  * - ESP32-C3 UART0 peripheral (primary debug interface)
  * - Standard GPIO pin assignments (TX: GPIO21, RX: GPIO20)
  * - 115200 baud rate with 8N1 configuration
- * - Polling-based transmission for bare-metal reliability
+ * - Interrupt-driven transmission and reception through ring buffers
  *
  * @version 1.0
  * @date 23-08-2025
@@ -54,6 +54,7 @@
  * across different compilation environments and maintain hardware compatibility.
  */
 #include <stdint.h>
+#include <stddef.h>
 
 /*
  * UART Driver Configuration Constants
@@ -74,6 +75,21 @@
 /** GPIO pin number for UART receive signal */
 #define KUMOTRAIL_UART_RX_PIN       20U
 
+/** Size of the software TX ring buffer in bytes (must be a power of two) */
+#define KUMOTRAIL_UART_TX_RING_SIZE 1024U
+
+/** Size of the software RX ring buffer in bytes (must be a power of two) */
+#define KUMOTRAIL_UART_RX_RING_SIZE 512U
+
+/**
+ * @brief What uart_puts() does when the TX ring buffer is full
+ */
+typedef enum
+{
+    UART_TX_POLICY_BLOCK, /**< Wait for space by draining the ring by hand */
+    UART_TX_POLICY_DROP   /**< Discard whatever does not fit */
+} uart_tx_policy_t;
+
 /*
  * Public Function Declarations
  *
@@ -116,48 +132,46 @@
 void uart_init(void);
 
 /**
- * @brief Transmit null-terminated string via UART0
+ * @brief Queue bytes for transmission without blocking
  *
- * Sends each character of the input string sequentially over the UART
- * interface using polling-based transmission with hardware flow control.
- * The function blocks until the entire string has been transmitted or
- * a null terminator is encountered.
+ * Copies as much of the buffer as fits into the TX ring buffer and returns
+ * immediately. The TXFIFO-empty interrupt moves the queued bytes into the
+ * 128-byte hardware FIFO as it drains, so the caller never waits on the
+ * baud rate.
  *
- * Transmission Characteristics:
- * - Character-by-character sequential transmission
- * - Hardware FIFO flow control prevents data loss
- * - Automatic null-termination detection
- * - Blocking operation until completion
- * - No character encoding conversion (raw byte transmission)
+ * @param buf Bytes to send
+ * @param len Number of bytes to send
+ * @return Number of bytes queued; less than len if the ring filled up
+ *
+ * @note Safe to call from interrupt context
+ */
+size_t uart_write(const void *buf, size_t len);
+
+/**
+ * @brief Transmit null-terminated string via UART0
+ *
+ * Queues the string through uart_write(). If the TX ring buffer fills up,
+ * the configured policy decides what happens to the remainder: with
+ * UART_TX_POLICY_BLOCK (the default) the caller drains the ring into the
+ * hardware FIFO itself until everything is queued, with
+ * UART_TX_POLICY_DROP the remainder is discarded and the call returns.
  *
  * Performance Considerations:
- * - Transmission rate limited by configured baud rate (115200 bps)
- * - CPU blocks during entire transmission process
- * - Typical character transmission time: ~87 microseconds at 115200 baud
- * - String length directly affects blocking duration
+ * - Returns as soon as the string is queued; a 1 KB line costs a copy,
+ *   not ~90 ms of waiting at 115200 baud
+ * - Only a full ring under the block policy makes the caller wait
  *
  * Error Handling:
  * - NULL pointer input results in immediate return (safe no-op)
- * - No buffer overflow protection (relies on null termination)
- * - Hardware transmission errors are not detected or reported
  *
  * @param s Pointer to null-terminated string for transmission
- *          Must point to valid memory containing null-terminated data
- *          Maximum practical length limited by system responsiveness needs
  *
  * @pre uart_init() must have been called successfully
  * @pre Input string must be null-terminated
- * @pre String memory must remain valid during function execution
- *
- * @post All characters transmitted via UART0 (excluding null terminator)
- * @post CPU execution blocked until transmission completion
  *
- * @note Function is not reentrant - external synchronization required
- * @note No flow control from receiving device is implemented
- * @note Consider transmission time impact on real-time system requirements
- *
- * @warning Long strings may cause system responsiveness issues
- * @warning NULL pointer input performs no operation (silent failure)
+ * @note Safe to call from interrupt context; the block policy drains by
+ *       polling the FIFO instead of waiting for the ISR, masking
+ *       interrupts only around each ring update
  *
  * Usage Example:
  * @code
@@ -166,10 +180,58 @@ void uart_init(void);
  * uart_puts("System ready for operation\n");
  * @endcode
  *
- * @see uart_init() for required initialization before usage
+ * @see uart_set_tx_policy() to choose between blocking and dropping
  */
 void uart_puts(const char *s);
 
+/**
+ * @brief Select what uart_puts() does when the TX ring buffer is full
+ * @param policy UART_TX_POLICY_BLOCK or UART_TX_POLICY_DROP
+ */
+void uart_set_tx_policy(uart_tx_policy_t policy);
+
+/**
+ * @brief Read received bytes without blocking
+ *
+ * Received data is moved from the hardware RX FIFO into a software ring
+ * buffer in bulk by the RX FIFO-full and RX-timeout interrupts, so bytes
+ * arrive in batches rather than one interrupt per byte. This call copies
+ * whatever is buffered.
+ *
+ * @param buf Destination buffer
+ * @param len Capacity of the destination buffer
+ * @return Number of bytes copied, 0 if nothing was received
+ *
+ * @note Safe to call from interrupt context
+ */
+size_t uart_read(void *buf, size_t len);
+
+/**
+ * @brief Read received bytes, waiting until at least one is available
+ *
+ * The calling task is blocked while the ring is empty. The RX interrupt
+ * wakes it, and it runs straight away if it is the most urgent task.
+ * Several tasks may wait at once; the most urgent one reads first.
+ *
+ * @param buf Destination buffer
+ * @param len Capacity of the destination buffer
+ * @return Number of bytes copied (at least 1 unless len is 0). From an
+ *         interrupt handler it does not wait and may return 0.
+ */
+size_t uart_read_blocking(void *buf, size_t len);
+
+/**
+ * @brief UART0 interrupt handler
+ *
+ * Moves received bytes from the hardware RX FIFO into the RX ring buffer,
+ * refills the hardware TX FIFO from the TX ring buffer on TXFIFO-empty and
+ * disables that interrupt once the TX ring is drained. Registered for
+ * INTERRUPT_LINE_UART0 by uart_init().
+ *
+ * @param arg Unused
+ */
+void uart_handle_interrupt(void *arg);
+
 /*
  * Future Enhancement Opportunities
  *
@@ -179,10 +241,8 @@ void uart_puts(const char *s);
  * Potential Additions:
  * - uart_putc() for single character transmission
  * - uart_printf() for formatted output support
- * - uart_gets() for string reception functionality
  * - uart_set_baud_rate() for runtime baud rate modification
  * - uart_get_status() for hardware status monitoring
- * - Interrupt-driven transmission for non-blocking operation
  * - DMA support for high-performance bulk data transfer
  * - Multi-UART instance support (UART1, UART2)
  * - Hardware flow control (RTS/CTS) implementation
@@ -203,5 +263,5 @@ void uart_puts(const char *s);
  * - Include this header in any source file requiring UART functionality
  * - Link against uart.c implementation for complete driver functionality
  * - Ensure proper initialization sequence in system boot code
- * - Consider timing implications of blocking transmission operations
+ * - Choose a TX full policy that suits the real-time needs of the caller
  */
\ No newline at end of file
@@ -25,6 +25,8 @@
 #include "timer.h"
 #include "sysctl.h"
 #include "interrupt.h"
+#include "kernel.h"
+#include "irq.h"
 #include <stdint.h>
 #include <stddef.h>
 
@@ -35,11 +37,15 @@
 
 // ===== TIMG_0 Register Definitions =====
 #define TIMG_0_T0CONFIG_REG         (*(volatile uint32_t*)(TIMG_0_BASE_ADDR + 0x0000))
+#define TIMG_0_T0LO_REG             (*(volatile uint32_t*)(TIMG_0_BASE_ADDR + 0x0004))
+#define TIMG_0_T0HI_REG             (*(volatile uint32_t*)(TIMG_0_BASE_ADDR + 0x0008))
+#define TIMG_0_T0UPDATE_REG         (*(volatile uint32_t*)(TIMG_0_BASE_ADDR + 0x000C))
 #define TIMG_0_T0ALARMLO_REG        (*(volatile uint32_t*)(TIMG_0_BASE_ADDR + 0x0010))
 #define TIMG_0_T0ALARMHI_REG        (*(volatile uint32_t*)(TIMG_0_BASE_ADDR + 0x0014))
 #define TIMG_0_T0LOAD_REG           (*(volatile uint32_t*)(TIMG_0_BASE_ADDR + 0x0020))
 #define TIMG_0_WDTFEED_REG          (*(volatile uint32_t*)(TIMG_0_BASE_ADDR + 0x0060))
 #define TIMG_0_INT_ENA_TIMERS_REG   (*(volatile uint32_t*)(TIMG_0_BASE_ADDR + 0x0070))
+#define TIMG_0_INT_RAW_TIMERS_REG   (*(volatile uint32_t*)(TIMG_0_BASE_ADDR + 0x0074))
 #define TIMG_0_INT_CLR_TIMERS_REG   (*(volatile uint32_t*)(TIMG_0_BASE_ADDR + 0x007C))
 
 // ===== TIMG_1 Register Definitions =====
@@ -65,19 +71,65 @@
 #define TIMG_0_T0_ALARM_EN            (1U << 10)
 #define TIMG_0_T0_INT_ENA             (1U << 0)
 #define TIMG_0_T0_INT_CLR             (1U << 0)
+#define TIMG_0_T0_INT_RAW             (1U << 0)
+#define TIMG_0_T0_UPDATE              (1U << 31)
+
+// --- Bit Masks for TIMG1 ---
+#define TIMG_1_T0_EN                  (1U << 31)
+#define TIMG_1_T0_INCREASE            (1U << 30)
+#define TIMG_1_T0_DIVIDER_SHIFT       13
+#define TIMG_1_T0_UPDATE              (1U << 31)
 
 // --- Configuration Constants ---
-#define KERNEL_TICK_HZ              100
 #define TIMG_CLOCK_FREQ             80000000
 #define TIMG_PRESCALER              1600
 #define TIMG_ALARM_VALUE            (TIMG_CLOCK_FREQ / TIMG_PRESCALER / KERNEL_TICK_HZ)
-#define TIMER_INTERRUPT_LINE        6
+#define TIMEBASE_PRESCALER          (TIMG_CLOCK_FREQ / TIMER_TIMEBASE_HZ)
 
 /** @brief Static callback function pointer for timer interrupts */
 static void (*timer_callback)(void) = NULL;
 
+/** @brief Non-zero while the periodic tick is suppressed by the idle task */
+static volatile uint32_t timer_ticks_suppressed = 0;
+
+/**
+ * @brief TIMG0_T0 count of the last tick boundary accounted for
+ *
+ * 0 while the counter reloads at every boundary. After a tickless period
+ * the counter is left running, since resetting it would lose the counts
+ * that pass while doing so; this then holds the boundary the counter has
+ * reached, until the next alarm reloads it. On a mostly idle system that
+ * can take arbitrarily long, so it is kept in full 54-bit counter width.
+ */
+static uint64_t timer_grid_counts = 0;
+
+/**
+ * @brief Latch and read the TIMG0_T0 counter
+ *
+ * The counter runs in the timer's own clock domain, so the latch request
+ * must complete before T0LO/T0HI hold a coherent value.
+ */
+static uint64_t timer_read_tick_counter(void)
+{
+    TIMG_0_T0UPDATE_REG = TIMG_0_T0_UPDATE;
+    while (TIMG_0_T0UPDATE_REG & TIMG_0_T0_UPDATE);
+    return ((uint64_t)TIMG_0_T0HI_REG << 32) | TIMG_0_T0LO_REG;
+}
+
+/**
+ * @brief Program the 54-bit alarm value
+ */
+static void timer_set_alarm(uint64_t value)
+{
+    TIMG_0_T0ALARMLO_REG = (uint32_t)value;
+    TIMG_0_T0ALARMHI_REG = (uint32_t)(value >> 32);
+}
+
 /**
  * @brief Set the timer interrupt callback function
+ *
+ * Not called for ticks suppressed by tickless idle, see timer.h.
+ *
  * @param callback Function to call on each timer interrupt, or NULL to disable
  */
 void timer_set_callback(void (*callback)(void))
@@ -85,14 +137,36 @@ void timer_set_callback(void (*callback)(void))
     timer_callback = callback;
 }
 
+/**
+ * @brief Start TIMG1_T0 as the free-running monotonic timebase
+ *
+ * The 54-bit up-counter runs at TIMER_TIMEBASE_HZ with no alarm and no
+ * reload, so it wraps only after decades and never raises an interrupt.
+ */
+static void timer_timebase_init(void)
+{
+    sysctl_enable_clock(PERIPH_TIMG1);
+    sysctl_reset_peripheral(PERIPH_TIMG1);
+
+    TIMG_1_T0CONFIG_REG = (TIMEBASE_PRESCALER << TIMG_1_T0_DIVIDER_SHIFT) |
+                          TIMG_1_T0_INCREASE;
+    TIMG_1_T0LOADLO_REG = 0;
+    TIMG_1_T0LOADHI_REG = 0;
+    TIMG_1_T0LOAD_REG = 0;
+    TIMG_1_T0CONFIG_REG |= TIMG_1_T0_EN;
+}
+
 /**
  * @brief Initialize Timer Group 0 Timer 0 for 100Hz periodic interrupts
  * 
  * Configures TIMG0_T0 with prescaler and alarm value to generate interrupts
  * at KERNEL_TICK_HZ frequency. Sets up interrupt routing and enables the timer.
+ * Also starts the TIMG1 monotonic timebase behind timer_now_us().
  */
 void timer_init(void)
 {
+   timer_timebase_init();
+
    sysctl_enable_clock(PERIPH_TIMG0);
    sysctl_reset_peripheral(PERIPH_TIMG0);
 
@@ -105,8 +179,9 @@ void timer_init(void)
                          (TIMG_PRESCALER << TIMG_0_T0_DIVIDER_SHIFT) |
                          TIMG_0_T0_INCREASE | TIMG_0_T0_AUTORELOAD;
 
-   interrupt_route(INTERRUPT_SOURCE_TIMG0_T0, TIMER_INTERRUPT_LINE);
-   interrupt_enable(TIMER_INTERRUPT_LINE);
+   interrupt_set_type(INTERRUPT_LINE_TIMER, INTERRUPT_TYPE_LEVEL);
+   interrupt_set_priority(INTERRUPT_LINE_TIMER, INTERRUPT_PRIORITY_TIMER);
+   interrupt_attach(INTERRUPT_SOURCE_TIMG0_T0, timer_handle_interrupt, NULL);
    TIMG_0_INT_ENA_TIMERS_REG |= TIMG_0_T0_INT_ENA;
 
    TIMG_0_T0LOAD_REG = 0;
@@ -119,14 +194,118 @@ void timer_init(void)
  * Called when TIMG0_T0 alarm fires. Feeds the watchdog, clears the interrupt,
  * calls the user callback if set, and re-enables the alarm.
  */
-void timer_handle_interrupt(void)
+void timer_handle_interrupt(void *arg)
 {
+    (void)arg;
+
     TIMG_0_WDTFEED_REG = 1;
 
     TIMG_0_INT_CLR_TIMERS_REG = TIMG_0_T0_INT_CLR;
 
+    if (timer_ticks_suppressed) {
+        // Wakeup alarm: timer_resume_ticks() accounts for the elapsed ticks.
+        return;
+    }
+
+    if (timer_grid_counts) {
+        // First boundary after a tickless period: the counter has just
+        // reloaded to 0, so go back to one tick per alarm.
+        timer_set_alarm(TIMG_ALARM_VALUE);
+        timer_grid_counts = 0;
+    }
+
     if (timer_callback) {
         timer_callback();
     }
     TIMG_0_T0CONFIG_REG |= TIMG_0_T0_ALARM_EN;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Stop the periodic tick and arm a single wakeup alarm
+ *
+ * Switches TIMG0_T0 from autoreload to free-running so the counter keeps
+ * measuring time from the last tick boundary, and moves the alarm to the
+ * boundary 'ticks' ticks after it. Must be called with interrupts disabled.
+ *
+ * @param ticks Number of whole ticks until the wakeup alarm
+ * @return 0 on success, -1 if a tick is already pending (nothing changed)
+ */
+int timer_suppress_ticks(uint32_t ticks)
+{
+    // With the alarm disabled no further boundary (and no reload) can occur,
+    // so the raw status tells whether one slipped in since the last tick.
+    TIMG_0_T0CONFIG_REG &= ~TIMG_0_T0_ALARM_EN;
+    if (TIMG_0_INT_RAW_TIMERS_REG & TIMG_0_T0_INT_RAW) {
+        TIMG_0_T0CONFIG_REG |= TIMG_0_T0_ALARM_EN;
+        return -1;
+    }
+
+    timer_set_alarm(timer_grid_counts + ticks * TIMG_ALARM_VALUE);
+    timer_ticks_suppressed = 1;
+    TIMG_0_T0CONFIG_REG = (TIMG_0_T0CONFIG_REG & ~TIMG_0_T0_AUTORELOAD) | TIMG_0_T0_ALARM_EN;
+    return 0;
+}
+
+/**
+ * @brief Restart the periodic tick after timer_suppress_ticks()
+ *
+ * Reads how far the counter has run, re-arms the alarm on the next tick
+ * boundary of the original grid and restores autoreload, so no time is
+ * lost or drifts across a tickless period. Must be called with interrupts
+ * disabled.
+ *
+ * @return Number of whole ticks that elapsed while the tick was suppressed
+ */
+uint32_t timer_resume_ticks(void)
+{
+    TIMG_0_T0CONFIG_REG &= ~TIMG_0_T0_ALARM_EN;
+
+    // Counts since the last accounted boundary, bounded by the longest
+    // tickless sleep, so the division stays 32-bit.
+    uint32_t since = (uint32_t)(timer_read_tick_counter() - timer_grid_counts);
+    uint32_t elapsed = since / TIMG_ALARM_VALUE;
+
+    // The wakeup alarm, if it fired, is covered by 'elapsed'.
+    TIMG_0_INT_CLR_TIMERS_REG = TIMG_0_T0_INT_CLR;
+
+    // An alarm value already behind the counter fires immediately, so a
+    // boundary crossed while re-arming is not lost.
+    // timer_handle_interrupt() restores the one-tick alarm once it fires.
+    timer_grid_counts += elapsed * TIMG_ALARM_VALUE;
+    timer_set_alarm(timer_grid_counts + TIMG_ALARM_VALUE);
+    timer_ticks_suppressed = 0;
+    TIMG_0_T0CONFIG_REG |= (TIMG_0_T0_AUTORELOAD | TIMG_0_T0_ALARM_EN);
+
+    return elapsed;
+}
+
+/**
+ * @brief Read the 64-bit monotonic timebase
+ *
+ * A write to T0UPDATE latches the whole counter into T0LO/T0HI at once, so
+ * the two halves always come from the same instant. Interrupts are masked
+ * so a nested reader cannot re-latch between the two loads.
+ *
+ * @return Timebase counts (TIMER_TIMEBASE_HZ) since timer_init()
+ */
+uint64_t timer_now_ticks64(void)
+{
+    uint32_t irq = irq_save();
+
+    TIMG_1_T0UPDATE_REG = TIMG_1_T0_UPDATE;
+    while (TIMG_1_T0UPDATE_REG & TIMG_1_T0_UPDATE);
+    uint32_t lo = TIMG_1_T0LO_REG;
+    uint32_t hi = TIMG_1_T0HI_REG;
+
+    irq_restore(irq);
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/**
+ * @brief Read the monotonic clock in microseconds
+ * @return Microseconds since timer_init()
+ */
+uint64_t timer_now_us(void)
+{
+    return timer_ticks64_to_us(timer_now_ticks64());
+}
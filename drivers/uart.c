@@ -18,21 +18,31 @@
  * @file uart.c
  * @brief Bare-metal UART0 driver for ESP32-C3 (KumoTrail kernel)
  *
- * Version: 1.3 | Date: 24-08-2025 | Author/Maintainer: fokaz-c
+ * Version: 1.4 | Date: 16-10-2026 | Author/Maintainer: fokaz-c
  */
 
 #include "uart.h"
 #include "sysctl.h"
+#include "interrupt.h"
+#include "irq.h"
+#include "scheduler.h"
+#include "waitqueue.h"
+#include "kernel.h"
 #include <stdint.h>
+#include <stddef.h>
 
 // --- Private Hardware Register Definitions ---
 #define UART0_BASE_ADDR               0x60000000U
 #define UART_FIFO_REG                 (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x00))
+#define UART_INT_RAW_REG              (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x04))
+#define UART_INT_ST_REG               (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x08))
+#define UART_INT_ENA_REG              (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x0C))
 #define UART_INT_CLR_REG              (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x10))
 #define UART_CLKDIV_REG               (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x14))
 #define UART_STATUS_REG               (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x1C))
 #define UART_CONF0_REG                (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x20))
 #define UART_CONF1_REG                (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x24))
+#define UART_MEM_CONF_REG             (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x60))
 #define UART_CLK_CONF_REG             (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x78))
 #define UART_ID_REG                   (*(volatile uint32_t*)(UART0_BASE_ADDR + 0x80))
 
@@ -47,6 +57,12 @@
 #define UART_SCLK_EN                  (1U << 22)
 #define UART_RST_CORE                 (1U << 23)
 #define UART_TX_SCLK_EN               (1U << 24)
+#define UART_RX_SCLK_EN               (1U << 25)
+#define UART_RXFIFO_FULL_THRHD_SHIFT  0U
+#define UART_RX_TOUT_EN               (1U << 21)
+#define UART_RX_TOUT_THRHD_SHIFT      16U
+#define UART_RX_TOUT_THRHD_MASK       (0x3FFU << UART_RX_TOUT_THRHD_SHIFT)
+#define UART_RXFIFO_CNT_MASK          0x3FFU
 #define UART_UPDATE_CTRL              (1U << 30)
 #define UART_REG_UPDATE               (1U << 31)
 #define UART_TXFIFO_CNT_SHIFT         16U
@@ -57,15 +73,106 @@
 #define UART_DATA_BITS_8              3U
 #define UART_STOP_BITS_1              1U
 #define UART_INT_CLEAR_ALL            0x3FFFFFU
+#define UART_RXFIFO_FULL_INT          (1U << 0)
+#define UART_TXFIFO_EMPTY_INT         (1U << 1)
+#define UART_RXFIFO_TOUT_INT          (1U << 8)
+#define UART_RX_INTS                  (UART_RXFIFO_FULL_INT | UART_RXFIFO_TOUT_INT)
+#define UART_RXFIFO_FULL_THRESHOLD    96U
+#define UART_RX_TOUT_BIT_TIMES        10U
+#define UART_TX_RING_MASK             (KUMOTRAIL_UART_TX_RING_SIZE - 1U)
+#define UART_RX_RING_MASK             (KUMOTRAIL_UART_RX_RING_SIZE - 1U)
 
-static void uart_putc(char c)
+/*
+ * TX ring buffer. uart_write() is the producer and advances the head,
+ * uart_tx_pump() is the consumer and advances the tail. Indices run freely
+ * and are masked on access, so head - tail is always the fill level.
+ */
+static uint8_t uart_tx_ring[KUMOTRAIL_UART_TX_RING_SIZE];
+static volatile uint32_t uart_tx_head = 0;
+static volatile uint32_t uart_tx_tail = 0;
+static volatile uart_tx_policy_t uart_tx_policy = UART_TX_POLICY_BLOCK;
+
+/*
+ * RX ring buffer. The UART interrupt is the producer, uart_read() the
+ * consumer. When the ring is full the RX interrupts are masked so further
+ * bytes wait in the 128-byte hardware FIFO instead of being dropped.
+ */
+static uint8_t uart_rx_ring[KUMOTRAIL_UART_RX_RING_SIZE];
+static volatile uint32_t uart_rx_head = 0;
+static volatile uint32_t uart_rx_tail = 0;
+
+/** Tasks blocked in uart_read_blocking(), woken by the RX interrupt. */
+static wait_queue_t uart_rx_waiters = WAIT_QUEUE_INIT;
+
+static uint32_t uart_txfifo_room(void)
+{
+    uint32_t fifo_count = (UART_STATUS_REG >> UART_TXFIFO_CNT_SHIFT) & UART_TXFIFO_CNT_MASK;
+    return fifo_count < UART_FIFO_DEPTH ? UART_FIFO_DEPTH - fifo_count : 0;
+}
+
+/*
+ * Move queued bytes into the hardware FIFO until either runs out, and stop
+ * the TXFIFO-empty interrupt once the ring is drained. Callers hold
+ * irq_save(): handlers run with MIE set, so without it a more urgent
+ * handler that prints could pump the same ring from under this one.
+ */
+static void uart_tx_pump(void)
 {
-    uint32_t fifo_count;
-    do
+    uint32_t room = uart_txfifo_room();
+    uint32_t tail = uart_tx_tail;
+
+    while (room && tail != uart_tx_head)
+    {
+        UART_FIFO_REG = uart_tx_ring[tail & UART_TX_RING_MASK];
+        tail++;
+        room--;
+    }
+    uart_tx_tail = tail;
+
+    if (tail == uart_tx_head)
     {
-        fifo_count = (UART_STATUS_REG >> UART_TXFIFO_CNT_SHIFT) & UART_TXFIFO_CNT_MASK;
-    } while (fifo_count >= UART_FIFO_THRESHOLD);
-    UART_FIFO_REG = (uint32_t)c;
+        UART_INT_ENA_REG &= ~UART_TXFIFO_EMPTY_INT;
+    }
+}
+
+/*
+ * Copy everything the hardware RX FIFO holds into the ring buffer in one
+ * pass. Called from the UART interrupt under irq_save(); the matrix
+ * threshold only keeps the UART line itself from nesting, not more urgent
+ * handlers that read the ring or touch UART_INT_ENA_REG.
+ */
+static void uart_rx_drain(void)
+{
+    uint32_t count = UART_STATUS_REG & UART_RXFIFO_CNT_MASK;
+    uint32_t head = uart_rx_head;
+    uint32_t space = KUMOTRAIL_UART_RX_RING_SIZE - (head - uart_rx_tail);
+
+    if (count > space)
+    {
+        count = space;
+    }
+    while (count--)
+    {
+        uart_rx_ring[head & UART_RX_RING_MASK] = (uint8_t)UART_FIFO_REG;
+        head++;
+    }
+    uart_rx_head = head;
+
+    if (head != uart_rx_tail)
+    {
+        // Wake every reader; each one re-reads, and those that find the
+        // ring emptied by the others go back to waiting.
+        task_t *task;
+        while ((task = wait_queue_peek(&uart_rx_waiters)))
+        {
+            scheduler_wake_waiter(task);
+        }
+    }
+
+    if (head - uart_rx_tail == KUMOTRAIL_UART_RX_RING_SIZE)
+    {
+        UART_INT_ENA_REG &= ~UART_RX_INTS;
+    }
 }
 
 void uart_init(void)
@@ -83,7 +190,7 @@ void uart_init(void)
     UART_ID_REG &= ~UART_UPDATE_CTRL;
 
     // --- 4. Clock Source Selection and TX Enable ---
-    UART_CLK_CONF_REG = (1 << UART_SCLK_SEL_SHIFT) | UART_SCLK_EN | UART_TX_SCLK_EN;
+    UART_CLK_CONF_REG = (1 << UART_SCLK_SEL_SHIFT) | UART_SCLK_EN | UART_TX_SCLK_EN | UART_RX_SCLK_EN;
 
     // --- 5. Baud Rate Configuration ---
     uint32_t divisor_integer = ESP32C3_APB_CLK_FREQ / KUMOTRAIL_UART_BAUD_RATE;
@@ -97,8 +204,12 @@ void uart_init(void)
     conf0_value &= ~UART_PARITY_EN;
     UART_CONF0_REG = conf0_value;
 
-    // --- 7. TX FIFO Empty Threshold ---
-    UART_CONF1_REG = (10 << UART_TXFIFO_EMPTY_THRHD_SHIFT);
+    // --- 7. TX FIFO Empty, RX FIFO Full and RX Timeout Thresholds ---
+    UART_CONF1_REG = (10 << UART_TXFIFO_EMPTY_THRHD_SHIFT)
+                   | (UART_RXFIFO_FULL_THRESHOLD << UART_RXFIFO_FULL_THRHD_SHIFT)
+                   | UART_RX_TOUT_EN;
+    UART_MEM_CONF_REG = (UART_MEM_CONF_REG & ~UART_RX_TOUT_THRHD_MASK)
+                      | (UART_RX_TOUT_BIT_TIMES << UART_RX_TOUT_THRHD_SHIFT);
 
     // --- 8. Final Synchronization ---
     UART_ID_REG |= UART_REG_UPDATE;
@@ -108,6 +219,54 @@ void uart_init(void)
     UART_CONF0_REG |= (UART_TXFIFO_RST | UART_RXFIFO_RST);
     UART_CONF0_REG &= ~(UART_TXFIFO_RST | UART_RXFIFO_RST);
     UART_INT_CLR_REG = UART_INT_CLEAR_ALL;
+
+    // --- 10. Interrupt-Driven Transmission and Reception ---
+    uart_tx_head = 0;
+    uart_tx_tail = 0;
+    uart_rx_head = 0;
+    uart_rx_tail = 0;
+    UART_INT_ENA_REG = UART_RX_INTS;
+    interrupt_set_type(INTERRUPT_LINE_UART0, INTERRUPT_TYPE_LEVEL);
+    interrupt_set_priority(INTERRUPT_LINE_UART0, INTERRUPT_PRIORITY_UART0);
+    interrupt_attach(INTERRUPT_SOURCE_UART0, uart_handle_interrupt, NULL);
+}
+
+void uart_set_tx_policy(uart_tx_policy_t policy)
+{
+    uart_tx_policy = policy;
+}
+
+size_t uart_write(const void *buf, size_t len)
+{
+    const uint8_t *data = (const uint8_t *)buf;
+    size_t written = 0;
+
+    if (!data)
+    {
+        return 0;
+    }
+
+    uint32_t irq = irq_save();
+
+    uint32_t head = uart_tx_head;
+    uint32_t space = KUMOTRAIL_UART_TX_RING_SIZE - (head - uart_tx_tail);
+    while (written < len && space)
+    {
+        uart_tx_ring[head & UART_TX_RING_MASK] = data[written++];
+        head++;
+        space--;
+    }
+    uart_tx_head = head;
+
+    // Prime the FIFO right away; the interrupt only keeps it topped up.
+    uart_tx_pump();
+    if (uart_tx_tail != uart_tx_head)
+    {
+        UART_INT_ENA_REG |= UART_TXFIFO_EMPTY_INT;
+    }
+
+    irq_restore(irq);
+    return written;
 }
 
 void uart_puts(const char *s)
@@ -116,8 +275,123 @@ void uart_puts(const char *s)
     {
         return;
     }
-    while (*s)
+
+    size_t len = 0;
+    while (s[len])
+    {
+        len++;
+    }
+
+    while (len)
+    {
+        size_t written = uart_write(s, len);
+        s += written;
+        len -= written;
+
+        if (!len || uart_tx_policy == UART_TX_POLICY_DROP)
+        {
+            return;
+        }
+
+        // Ring full under the block policy: drain it by hand rather than
+        // wait for the ISR, which may be masked or below the caller. Poll
+        // for FIFO room with interrupts as the caller left them and take
+        // the lock only for the ring update itself.
+        while (!uart_txfifo_room())
+        {
+        }
+        uint32_t irq = irq_save();
+        uart_tx_pump();
+        irq_restore(irq);
+    }
+}
+
+size_t uart_read(void *buf, size_t len)
+{
+    uint8_t *data = (uint8_t *)buf;
+    size_t count = 0;
+
+    if (!data)
+    {
+        return 0;
+    }
+
+    uint32_t irq = irq_save();
+
+    uint32_t tail = uart_rx_tail;
+    while (count < len && tail != uart_rx_head)
+    {
+        data[count++] = uart_rx_ring[tail & UART_RX_RING_MASK];
+        tail++;
+    }
+    uart_rx_tail = tail;
+
+    // There is room again: let bytes parked in the hardware FIFO in.
+    if (count)
+    {
+        UART_INT_ENA_REG |= UART_RX_INTS;
+    }
+
+    irq_restore(irq);
+    return count;
+}
+
+size_t uart_read_blocking(void *buf, size_t len)
+{
+    size_t count;
+
+    if (!buf || !len)
+    {
+        return 0;
+    }
+
+    // A handler cannot block: it would stall the task it interrupted.
+    if (task_current() && !scheduler_in_task())
+    {
+        return uart_read(buf, len);
+    }
+
+    while (!(count = uart_read(buf, len)))
+    {
+        uint32_t irq = irq_save();
+
+        // Re-check under the mask: a byte may have arrived meanwhile.
+        if (uart_rx_head == uart_rx_tail)
+        {
+            if (task_current())
+            {
+                // The RX interrupt wakes us and the switch back is immediate.
+                scheduler_wait(&uart_rx_waiters, KERNEL_WAIT_FOREVER);
+            }
+            else
+            {
+                // No scheduler yet: sleep the core until the next interrupt.
+                asm volatile ("wfi");
+            }
+        }
+
+        irq_restore(irq);
+    }
+    return count;
+}
+
+void uart_handle_interrupt(void *arg)
+{
+    (void)arg;
+
+    // interrupt_dispatch() runs handlers with MIE set; the ring updates
+    // below are short, so keep more urgent handlers out for their duration.
+    uint32_t irq = irq_save();
+    uint32_t status = UART_INT_ST_REG;
+
+    if (status & UART_RX_INTS)
+    {
+        uart_rx_drain();
+    }
+    if (status & UART_TXFIFO_EMPTY_INT)
     {
-        uart_putc(*s++);
+        uart_tx_pump();
     }
+    UART_INT_CLR_REG = status;
+    irq_restore(irq);
 }
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KUMOTRAIL_BITOPS_H
+#define KUMOTRAIL_BITOPS_H
+
+/**
+ * @file bitops.h
+ * @brief Bit manipulation helpers for the KumoTrail kernel.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ */
+
+#include <stdint.h>
+
+/**
+ * @brief Count trailing zero bits of a non-zero word.
+ *
+ * rv32imc has no Zbb ctz/clz instructions. The lowest set bit is isolated
+ * with (value & -value) and a de Bruijn multiply turns it into a unique
+ * 5-bit index, so the lookup is branch-free and constant time.
+ *
+ * @param value Word to scan. The result is undefined when value is zero.
+ * @return Index (0-31) of the lowest set bit.
+ */
+static inline uint32_t bitops_ctz32(uint32_t value)
+{
+    static const uint8_t debruijn_ctz32[32] = {
+         0,  1, 28,  2, 29, 14, 24,  3, 30, 22, 20, 15, 25, 17,  4,  8,
+        31, 27, 13, 23, 21, 19, 16,  7, 26, 12, 18,  6, 11,  5, 10,  9
+    };
+
+    return debruijn_ctz32[((value & -value) * 0x077CB531U) >> 27];
+}
+
+#endif /* KUMOTRAIL_BITOPS_H */
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file eventgroup.h
+ * @brief Groups of 32 event flags that tasks can wait on.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * A task waits for any or all of a set of flags. Setting flags checks each
+ * waiter in priority order and wakes only those whose condition now holds,
+ * handing each the flag value that satisfied it, instead of waking every
+ * waiter to look for itself.
+ */
+
+#ifndef KUMOTRAIL_EVENTGROUP_H
+#define KUMOTRAIL_EVENTGROUP_H
+
+#include <stdint.h>
+#include "waitqueue.h"
+
+/** Wait until any of the requested flags is set. */
+#define EVENT_WAIT_ANY          0x0U
+
+/** Wait until all of the requested flags are set. */
+#define EVENT_WAIT_ALL          0x1U
+
+/** Clear the requested flags when the wait is satisfied. */
+#define EVENT_CLEAR_ON_EXIT     0x2U
+
+/**
+ * @brief Event group object. Treat all fields as private.
+ */
+typedef struct event_group {
+    uint32_t flags;             // Current flag values.
+    wait_queue_t waiters;       // Tasks blocked in event_group_wait().
+} event_group_t;
+
+/** Static initializer for an event_group_t with all flags clear. */
+#define EVENT_GROUP_INIT { .flags = 0, .waiters = WAIT_QUEUE_INIT }
+
+/**
+ * @brief Prepares an event group with all flags clear.
+ */
+void event_group_init(event_group_t *group);
+
+/**
+ * @brief Sets flags and wakes the waiters they satisfy.
+ *
+ * All waiters are checked against the same flag value; flags consumed with
+ * EVENT_CLEAR_ON_EXIT are cleared once they have all been served. Safe to
+ * call from interrupt handlers and tasks.
+ *
+ * @param group Event group to update.
+ * @param bits Flags to set.
+ * @return The flags after setting and any clearing by woken waiters.
+ */
+uint32_t event_group_set(event_group_t *group, uint32_t bits);
+
+/**
+ * @brief Clears flags. Safe to call from interrupt handlers and tasks.
+ * @return The flags before clearing.
+ */
+uint32_t event_group_clear(event_group_t *group, uint32_t bits);
+
+/**
+ * @brief Returns the current flags.
+ */
+uint32_t event_group_get(const event_group_t *group);
+
+/**
+ * @brief Waits for a combination of flags.
+ *
+ * Call from task context; interrupt handlers may only use KERNEL_NO_WAIT.
+ *
+ * @param group Event group to wait on.
+ * @param bits Flags to wait for. Must not be 0.
+ * @param options EVENT_WAIT_ANY or EVENT_WAIT_ALL, optionally ORed with
+ *                EVENT_CLEAR_ON_EXIT.
+ * @param timeout_ms Minimum wait in milliseconds before timing out (up to
+ *                   one tick more), KERNEL_NO_WAIT or KERNEL_WAIT_FOREVER.
+ * @return The flags at the moment the condition held, before any clearing,
+ *         or 0 on timeout.
+ */
+uint32_t event_group_wait(event_group_t *group, uint32_t bits, uint32_t options,
+                          uint32_t timeout_ms);
+
+#endif /* KUMOTRAIL_EVENTGROUP_H */
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file idle.h
+ * @brief Kernel idle task and CPU load accounting.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ */
+
+#ifndef KUMOTRAIL_IDLE_H
+#define KUMOTRAIL_IDLE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Returns the CPU load over the sliding window.
+ *
+ * The window covers the last KERNEL_LOAD_WINDOW sample periods of
+ * KERNEL_LOAD_SAMPLE_MS each, plus the period in progress. Time spent in
+ * interrupt handlers counts as busy.
+ *
+ * @return Busy time in percent, 0 to 100.
+ */
+uint32_t idle_cpu_load(void);
+
+/*
+ * Kernel-internal interface
+ */
+
+/**
+ * @brief Kernel idle task, declared with TASK_DEFINE() at
+ * KERNEL_IDLE_PRIORITY. Sleeps in wfi whenever it runs.
+ */
+void idle_task(void);
+
+#endif /* KUMOTRAIL_IDLE_H */
@@ -28,16 +28,164 @@
  * @author fokaz-c
  */
 
+#include <stdint.h>
+
 
 
 
 /**
- * @brief Hardware interrupt sources (TRM values).
+ * @brief Hardware interrupt sources (ESP32-C3 TRM, Interrupt Matrix).
+ *
+ * The value is the index of the source's map register and its bit in the
+ * INTR_STATUS registers.
  */
 typedef enum {
-    INTERRUPT_SOURCE_TIMG0_T0 = 32 /**< Timer Group 0, Timer 0 interrupt */
+    INTERRUPT_SOURCE_WIFI_MAC             =  0, /**< Wi-Fi MAC */
+    INTERRUPT_SOURCE_WIFI_MAC_NMI         =  1, /**< Wi-Fi MAC NMI */
+    INTERRUPT_SOURCE_WIFI_PWR             =  2, /**< Wi-Fi power */
+    INTERRUPT_SOURCE_WIFI_BB              =  3, /**< Wi-Fi baseband */
+    INTERRUPT_SOURCE_BT_MAC               =  4, /**< Bluetooth MAC */
+    INTERRUPT_SOURCE_BT_BB                =  5, /**< Bluetooth baseband */
+    INTERRUPT_SOURCE_BT_BB_NMI            =  6, /**< Bluetooth baseband NMI */
+    INTERRUPT_SOURCE_RWBT                 =  7, /**< Bluetooth link layer */
+    INTERRUPT_SOURCE_RWBLE                =  8, /**< BLE link layer */
+    INTERRUPT_SOURCE_RWBT_NMI             =  9, /**< Bluetooth link layer NMI */
+    INTERRUPT_SOURCE_RWBLE_NMI            = 10, /**< BLE link layer NMI */
+    INTERRUPT_SOURCE_I2C_MST              = 11, /**< Internal I2C master (analog) */
+    INTERRUPT_SOURCE_SLC0                 = 12, /**< SDIO SLC channel 0 */
+    INTERRUPT_SOURCE_SLC1                 = 13, /**< SDIO SLC channel 1 */
+    INTERRUPT_SOURCE_APB_CTRL             = 14, /**< APB controller */
+    INTERRUPT_SOURCE_UHCI0                = 15, /**< UHCI0 (UART DMA) */
+    INTERRUPT_SOURCE_GPIO                 = 16, /**< GPIO */
+    INTERRUPT_SOURCE_GPIO_NMI             = 17, /**< GPIO NMI */
+    INTERRUPT_SOURCE_SPI1                 = 18, /**< SPI1 (flash) */
+    INTERRUPT_SOURCE_SPI2                 = 19, /**< SPI2 (general purpose) */
+    INTERRUPT_SOURCE_I2S                  = 20, /**< I2S */
+    INTERRUPT_SOURCE_UART0                = 21, /**< UART0 */
+    INTERRUPT_SOURCE_UART1                = 22, /**< UART1 */
+    INTERRUPT_SOURCE_LEDC                 = 23, /**< LED PWM controller */
+    INTERRUPT_SOURCE_EFUSE                = 24, /**< eFuse controller */
+    INTERRUPT_SOURCE_TWAI                 = 25, /**< TWAI (CAN) controller */
+    INTERRUPT_SOURCE_USB_SERIAL_JTAG      = 26, /**< USB Serial/JTAG */
+    INTERRUPT_SOURCE_RTC_CORE             = 27, /**< RTC core */
+    INTERRUPT_SOURCE_RMT                  = 28, /**< Remote control peripheral */
+    INTERRUPT_SOURCE_I2C_EXT0             = 29, /**< I2C controller 0 */
+    INTERRUPT_SOURCE_TIMER1               = 30, /**< Legacy timer 1 */
+    INTERRUPT_SOURCE_TIMER2               = 31, /**< Legacy timer 2 */
+    INTERRUPT_SOURCE_TIMG0_T0             = 32, /**< Timer Group 0, Timer 0 */
+    INTERRUPT_SOURCE_TIMG0_WDT            = 33, /**< Timer Group 0 watchdog */
+    INTERRUPT_SOURCE_TIMG1_T0             = 34, /**< Timer Group 1, Timer 0 */
+    INTERRUPT_SOURCE_TIMG1_WDT            = 35, /**< Timer Group 1 watchdog */
+    INTERRUPT_SOURCE_CACHE_IA             = 36, /**< Cache invalid access */
+    INTERRUPT_SOURCE_SYSTIMER_TARGET0     = 37, /**< System timer target 0 (edge) */
+    INTERRUPT_SOURCE_SYSTIMER_TARGET1     = 38, /**< System timer target 1 (edge) */
+    INTERRUPT_SOURCE_SYSTIMER_TARGET2     = 39, /**< System timer target 2 (edge) */
+    INTERRUPT_SOURCE_SPI_MEM_REJECT_CACHE = 40, /**< SPI memory rejected cache access */
+    INTERRUPT_SOURCE_ICACHE_PRELOAD0      = 41, /**< ICache preload done */
+    INTERRUPT_SOURCE_ICACHE_SYNC0         = 42, /**< ICache sync done */
+    INTERRUPT_SOURCE_APB_ADC              = 43, /**< SAR ADC */
+    INTERRUPT_SOURCE_DMA_CH0              = 44, /**< GDMA channel 0 */
+    INTERRUPT_SOURCE_DMA_CH1              = 45, /**< GDMA channel 1 */
+    INTERRUPT_SOURCE_DMA_CH2              = 46, /**< GDMA channel 2 */
+    INTERRUPT_SOURCE_RSA                  = 47, /**< RSA accelerator */
+    INTERRUPT_SOURCE_AES                  = 48, /**< AES accelerator */
+    INTERRUPT_SOURCE_SHA                  = 49, /**< SHA accelerator */
+    INTERRUPT_SOURCE_FROM_CPU_INTR0       = 50, /**< Software interrupt 0 */
+    INTERRUPT_SOURCE_FROM_CPU_INTR1       = 51, /**< Software interrupt 1 */
+    INTERRUPT_SOURCE_FROM_CPU_INTR2       = 52, /**< Software interrupt 2 */
+    INTERRUPT_SOURCE_FROM_CPU_INTR3       = 53, /**< Software interrupt 3 */
+    INTERRUPT_SOURCE_ASSIST_DEBUG         = 54, /**< Debug assist */
+    INTERRUPT_SOURCE_DMA_APBPERI_PMS      = 55, /**< PMS: DMA APB peripheral violation */
+    INTERRUPT_SOURCE_CORE0_IRAM0_PMS      = 56, /**< PMS: IRAM0 violation */
+    INTERRUPT_SOURCE_CORE0_DRAM0_PMS      = 57, /**< PMS: DRAM0 violation */
+    INTERRUPT_SOURCE_CORE0_PIF_PMS        = 58, /**< PMS: PIF violation */
+    INTERRUPT_SOURCE_CORE0_PIF_PMS_SIZE   = 59, /**< PMS: PIF size violation */
+    INTERRUPT_SOURCE_BAK_PMS              = 60, /**< PMS: backup violation */
+    INTERRUPT_SOURCE_CACHE_CORE0_ACS      = 61, /**< Cache core 0 access violation */
+    INTERRUPT_SOURCE_MAX                  = 62  /**< Number of sources */
 } interrupt_source_t;
 
+/** Number of CPU interrupt lines (line 0 is reserved). */
+#define INTERRUPT_LINE_COUNT    32
+
+/**
+ * @brief Interrupt handler, called with the argument given at registration.
+ */
+typedef void (*interrupt_handler_t)(void *arg);
+
+/**
+ * @brief CPU interrupt line assignments (mcause interrupt numbers).
+ *
+ * Hot sources own a dedicated line so their handler is reached straight
+ * from the vector table. Every other source is multiplexed onto
+ * INTERRUPT_LINE_SHARED and found through the INTR_STATUS registers. The
+ * source-to-line ownership table lives in kernel/interrupt.c.
+ */
+#define INTERRUPT_LINE_SHARED   5   /**< Low-rate sources, demultiplexed */
+#define INTERRUPT_LINE_TIMER    6   /**< Kernel tick (TIMG0_T0) */
+#define INTERRUPT_LINE_UART0    7   /**< UART0 TX/RX */
+#define INTERRUPT_LINE_GPIO     8   /**< GPIO */
+#define INTERRUPT_LINE_SPI2     9   /**< SPI2 */
+#define INTERRUPT_LINE_DMA_CH0  10  /**< GDMA channel 0 */
+#define INTERRUPT_LINE_DMA_CH1  11  /**< GDMA channel 1 */
+#define INTERRUPT_LINE_DMA_CH2  12  /**< GDMA channel 2 */
+#define INTERRUPT_LINE_YIELD    13  /**< Scheduler yield (FROM_CPU_INTR0) */
+
+/**
+ * @brief CPU interrupt line priorities.
+ *
+ * Higher numbers are more urgent. A line at priority 0 never fires. While
+ * a handler runs, only lines of strictly higher priority can preempt it.
+ */
+#define INTERRUPT_PRIORITY_MIN      1
+#define INTERRUPT_PRIORITY_MAX      15
+
+#define INTERRUPT_PRIORITY_SHARED   1   /**< Demultiplexed low-rate sources */
+#define INTERRUPT_PRIORITY_TIMER    1   /**< Kernel tick and software timers */
+#define INTERRUPT_PRIORITY_UART0    3   /**< UART0 FIFOs must not overrun */
+#define INTERRUPT_PRIORITY_YIELD    1   /**< Never delays a real interrupt */
+
+/**
+ * @brief CPU interrupt line trigger type.
+ */
+typedef enum {
+    INTERRUPT_TYPE_LEVEL = 0,   /**< Fires while the source is asserted */
+    INTERRUPT_TYPE_EDGE  = 1    /**< Fires once per rising edge */
+} interrupt_type_t;
+
+
+/**
+ * @brief Attach a handler to a hardware interrupt source.
+ *
+ * Looks up the line the source owns in the routing table, routes the
+ * source there and enables the line. On a dedicated line the handler is
+ * installed in the vector path directly; on the shared line it is called
+ * by the demultiplexer when the source's status bit is set. Drivers set
+ * the priority and type of their dedicated line themselves.
+ *
+ * @param source Hardware interrupt source.
+ * @param handler Function to call when the source fires.
+ * @param arg Argument passed to the handler.
+ * @return 0 on success, -1 if the source is out of range or handler is NULL.
+ */
+int interrupt_attach(interrupt_source_t source, interrupt_handler_t handler, void *arg);
+
+/**
+ * @brief Detach the handler of a hardware interrupt source.
+ *
+ * The source is unrouted. A dedicated line is disabled; the shared line
+ * stays enabled for its other sources.
+ *
+ * @param source Hardware interrupt source.
+ */
+void interrupt_detach(interrupt_source_t source);
+
+/**
+ * @brief Returns the CPU line a source owns in the routing table.
+ * @param source Hardware interrupt source.
+ * @return CPU interrupt line, or 0 if the source is out of range.
+ */
+int interrupt_source_line(interrupt_source_t source);
 
 /**
  * @brief Route a hardware interrupt source to a CPU interrupt line.
@@ -58,4 +206,57 @@ void interrupt_enable(int cpu_line);
  */
 void interrupt_disable(int cpu_line);
 
+/**
+ * @brief Set the priority of a CPU interrupt line.
+ * @param cpu_line CPU interrupt line (1-31).
+ * @param priority 0 (never fires) to INTERRUPT_PRIORITY_MAX.
+ * @return 0 on success, -1 if the line or priority is out of range.
+ */
+int interrupt_set_priority(int cpu_line, uint32_t priority);
+
+/**
+ * @brief Set the trigger type of a CPU interrupt line.
+ *
+ * Edge lines are acknowledged by interrupt_dispatch() before the handler
+ * runs; level lines must be cleared at the peripheral by the handler.
+ *
+ * @param cpu_line CPU interrupt line (1-31).
+ * @param type Level or edge triggered.
+ * @return 0 on success, -1 if the line is out of range.
+ */
+int interrupt_set_type(int cpu_line, interrupt_type_t type);
+
+/**
+ * @brief Set the CPU priority threshold.
+ *
+ * Lines with a priority below the threshold are held off. trap_init() sets
+ * it to INTERRUPT_PRIORITY_MIN so every configured line can fire.
+ *
+ * @param threshold New threshold, INTERRUPT_PRIORITY_MIN to INTERRUPT_PRIORITY_MAX.
+ */
+void interrupt_set_threshold(uint32_t threshold);
+
+/**
+ * @brief Register the handler for a CPU interrupt line.
+ *
+ * Drivers call this from their init function, so adding a driver does
+ * not require touching the trap code.
+ *
+ * @param cpu_line CPU interrupt line (1-31).
+ * @param handler Function to call, or NULL to restore the default handler.
+ * @param arg Argument passed to the handler.
+ * @return 0 on success, -1 if the line is out of range.
+ */
+int interrupt_register_handler(int cpu_line, interrupt_handler_t handler, void *arg);
+
+/**
+ * @brief Run the handler registered for a CPU interrupt line.
+ *
+ * Called from the trap path with the interrupt number from mcause. The
+ * handler runs with MIE set and the threshold raised above the line's
+ * priority, so more urgent lines can nest on top of it.
+ * @param cpu_line CPU interrupt line that fired.
+ */
+void interrupt_dispatch(uint32_t cpu_line);
+
 #endif // KUMOTRAIL_INTERRUPT_H
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KUMOTRAIL_KERNEL_H
+#define KUMOTRAIL_KERNEL_H
+
+/**
+ * @file kernel.h
+ * @brief Kernel-wide configuration constants for KumoTrail.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ */
+
+/** Kernel tick rate in Hz. Must divide 1000. */
+#define KERNEL_TICK_HZ              100
+
+/** Milliseconds per kernel tick. */
+#define KERNEL_TICK_MS              (1000U / KERNEL_TICK_HZ)
+
+/** Converts milliseconds to kernel ticks, rounding up, for any 32-bit ms. */
+#define KERNEL_MS_TO_TICKS(ms)      ((ms) / KERNEL_TICK_MS + ((ms) % KERNEL_TICK_MS != 0U))
+
+/** Timeout for blocking calls that must not block at all. */
+#define KERNEL_NO_WAIT              0U
+
+/** Timeout for blocking calls that wait until they succeed. */
+#define KERNEL_WAIT_FOREVER         0xFFFFFFFFU
+
+/**
+ * Stop the periodic tick while only the idle task is ready (1 = enabled).
+ * The timer is then programmed for the next kernel deadline and the tick
+ * count is caught up from the hardware counter on wakeup.
+ */
+#define KERNEL_TICKLESS_IDLE        1
+
+/** Shortest idle period, in ticks, worth suppressing the tick for. */
+#define KERNEL_TICKLESS_MIN_IDLE_TICKS  2
+
+/** Longest single tickless sleep, in ticks, when nothing is due. */
+#define KERNEL_TICKLESS_MAX_IDLE_TICKS  (60 * KERNEL_TICK_HZ)
+
+/** Length of one CPU load sample period in milliseconds. */
+#define KERNEL_LOAD_SAMPLE_MS       125
+
+/** Number of sample periods in the CPU load sliding window. */
+#define KERNEL_LOAD_WINDOW          8
+
+/** Number of tasks task_create() can create at runtime. Tasks declared
+ *  with TASK_DEFINE(), such as the kernel idle task, are not counted. */
+#define KERNEL_MAX_TASKS            8
+
+/** Number of priority levels. Must not exceed 32 (one ready-bitmap word). */
+#define KERNEL_MAX_PRIORITIES       32
+
+/** Highest task priority. Lower numbers are more urgent. */
+#define KERNEL_HIGHEST_PRIORITY     0
+
+/** Priority of the idle task. Nothing else may run at this level. */
+#define KERNEL_IDLE_PRIORITY        (KERNEL_MAX_PRIORITIES - 1)
+
+/** Priority used by task_create() when none is given. */
+#define KERNEL_DEFAULT_PRIORITY     16
+
+/** Priority of the deferred-work worker task. */
+#define KERNEL_WORKQUEUE_PRIORITY   KERNEL_HIGHEST_PRIORITY
+
+/** Capacity of the deferred-work ring. Must be a power of two. */
+#define KERNEL_WORKQUEUE_DEPTH      32
+
+/** Stack size of each task in bytes. Must be a multiple of 16. */
+#define KERNEL_TASK_STACK_SIZE      2048
+
+/** Stack size of the kernel idle and worker tasks in bytes. */
+#define KERNEL_IDLE_STACK_SIZE      512
+#define KERNEL_WORKQUEUE_STACK_SIZE 1024
+
+/** Pattern unused stack words are filled with (also in boot.S). */
+#define KERNEL_STACK_PAINT          0xA5A5A5A5U
+
+#endif /* KUMOTRAIL_KERNEL_H */
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mempool.h
+ * @brief Fixed-size block pools for buffers passed between tasks.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Allocation and release are O(1) and safe from interrupt handlers. A pool
+ * never blocks: when it is empty, mempool_alloc() returns NULL. Blocks are
+ * word-aligned.
+ */
+
+#ifndef KUMOTRAIL_MEMPOOL_H
+#define KUMOTRAIL_MEMPOOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Block pool object. Treat all fields as private.
+ */
+typedef struct mempool {
+    uint8_t *storage;           // First block.
+    uint32_t block_size;        // Bytes per block, a multiple of 4.
+    uint32_t block_count;       // Blocks in storage.
+    uint32_t untouched;         // Index of the first never-allocated block.
+    void *free_list;            // Released blocks, linked through their first word.
+} mempool_t;
+
+/** Rounds a block size up so every block can hold the free-list link. */
+#define MEMPOOL_BLOCK_SIZE(size) \
+    ((((size) < sizeof(void *) ? sizeof(void *) : (size)) + 3U) & ~3U)
+
+/**
+ * @brief Defines a block pool and its storage. Use at file scope.
+ * @param name Name of the mempool_t object.
+ * @param size Usable bytes per block.
+ * @param count Number of blocks.
+ */
+#define MEMPOOL_DEFINE(name, size, count) \
+    static uint32_t name##_storage[(count) * MEMPOOL_BLOCK_SIZE(size) / sizeof(uint32_t)]; \
+    mempool_t name = { .storage = (uint8_t *)name##_storage, \
+                       .block_size = MEMPOOL_BLOCK_SIZE(size), .block_count = (count), \
+                       .untouched = 0, .free_list = NULL }
+
+/**
+ * @brief Prepares a pool over caller-provided storage.
+ * @param pool Pool to initialize.
+ * @param storage Word-aligned memory of count * MEMPOOL_BLOCK_SIZE(size) bytes.
+ * @param size Usable bytes per block.
+ * @param count Number of blocks.
+ */
+void mempool_init(mempool_t *pool, void *storage, uint32_t size, uint32_t count);
+
+/**
+ * @brief Takes a block from the pool.
+ * @return The block, or NULL if the pool is exhausted.
+ */
+void *mempool_alloc(mempool_t *pool);
+
+/**
+ * @brief Returns a block obtained from the same pool.
+ */
+void mempool_free(mempool_t *pool, void *block);
+
+#endif /* KUMOTRAIL_MEMPOOL_H */
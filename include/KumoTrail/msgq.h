@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file msgq.h
+ * @brief Fixed-capacity queues that pass message pointers between tasks.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * A message is a pointer, typically to a block from a mempool_t; the queue
+ * never touches the payload, so handing a buffer to the next stage costs
+ * the same whatever its size. Ownership of the buffer moves with the
+ * pointer: after a successful send the sender must not use it again, and
+ * the receiver becomes responsible for passing it on or freeing it.
+ *
+ * When a task is already waiting on the other side, the pointer is handed
+ * to it directly, bypassing the ring. Both wait queues are priority-ordered.
+ */
+
+#ifndef KUMOTRAIL_MSGQ_H
+#define KUMOTRAIL_MSGQ_H
+
+#include <stdint.h>
+#include "waitqueue.h"
+
+/**
+ * @brief Message queue object. Treat all fields as private.
+ */
+typedef struct msgq {
+    void **ring;                // Storage for 'capacity' pointers.
+    uint32_t capacity;          // Messages the ring can hold.
+    uint32_t head;              // Index of the oldest message.
+    uint32_t count;             // Messages in the ring.
+    wait_queue_t receivers;     // Tasks blocked in msgq_receive().
+    wait_queue_t senders;       // Tasks blocked in msgq_send().
+} msgq_t;
+
+/**
+ * @brief Defines a message queue and its ring storage. Use at file scope.
+ * @param name Name of the msgq_t object.
+ * @param cap Number of messages the queue can hold.
+ */
+#define MSGQ_DEFINE(name, cap) \
+    static void *name##_ring[(cap)]; \
+    msgq_t name = { .ring = name##_ring, .capacity = (cap), .head = 0, .count = 0, \
+                    .receivers = WAIT_QUEUE_INIT, .senders = WAIT_QUEUE_INIT }
+
+/**
+ * @brief Prepares an empty message queue.
+ * @param queue Queue to initialize.
+ * @param ring Storage for the message pointers.
+ * @param capacity Number of entries in ring. With 0, every send waits for
+ *                 a receiver and the message is handed over directly.
+ */
+void msgq_init(msgq_t *queue, void **ring, uint32_t capacity);
+
+/**
+ * @brief Posts a message, blocking while the queue is full.
+ *
+ * Interrupt handlers may call this with KERNEL_NO_WAIT; a task woken by it
+ * runs from the outermost trap exit.
+ *
+ * @param queue Queue to post to.
+ * @param msg Message pointer. Ownership passes to the receiver.
+ * @param timeout_ms Minimum wait in milliseconds before timing out (up to
+ *                   one tick more), KERNEL_NO_WAIT or KERNEL_WAIT_FOREVER.
+ * @return 0 if the message was queued or delivered, -1 on timeout, in which
+ *         case the caller still owns msg.
+ */
+int msgq_send(msgq_t *queue, void *msg, uint32_t timeout_ms);
+
+/**
+ * @brief Takes the oldest message, blocking while the queue is empty.
+ *
+ * Interrupt handlers may call this with KERNEL_NO_WAIT.
+ *
+ * @param queue Queue to read from.
+ * @param msg Receives the message pointer and its ownership.
+ * @param timeout_ms Minimum wait in milliseconds before timing out (up to
+ *                   one tick more), KERNEL_NO_WAIT or KERNEL_WAIT_FOREVER.
+ * @return 0 if a message was received, -1 on timeout.
+ */
+int msgq_receive(msgq_t *queue, void **msg, uint32_t timeout_ms);
+
+/**
+ * @brief Returns the number of messages waiting in the ring.
+ */
+uint32_t msgq_count(const msgq_t *queue);
+
+#endif /* KUMOTRAIL_MSGQ_H */
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mutex.h
+ * @brief Task mutexes with priority inheritance.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * While a task waits for a mutex, the owner runs at the waiter's priority
+ * if that is more urgent, and so does every owner further down a chain of
+ * nested locks. A task drops back once it releases the mutexes that
+ * boosted it. Locking and unlocking a free mutex costs a few instructions
+ * with interrupts masked and never traps.
+ *
+ * Mutexes are owned by tasks and must not be used from interrupt handlers.
+ * Before scheduler_start() they do nothing, so drivers can use them during
+ * bring-up.
+ */
+
+#ifndef KUMOTRAIL_MUTEX_H
+#define KUMOTRAIL_MUTEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "task.h"
+#include "waitqueue.h"
+
+/**
+ * @brief Mutex object. Treat all fields as private.
+ */
+typedef struct mutex {
+    task_t *owner;              // Task holding the mutex, NULL if free.
+    struct mutex *held_next;    // Next mutex held by the same owner.
+    struct mutex **held_pprev;  // Link pointing at this mutex while owned.
+    wait_queue_t waiters;       // Tasks blocked in mutex_lock().
+} mutex_t;
+
+/** Static initializer for a mutex_t. */
+#define MUTEX_INIT { .owner = NULL, .held_next = NULL, .held_pprev = NULL, \
+                     .waiters = WAIT_QUEUE_INIT }
+
+/**
+ * @brief Prepares a mutex in the unlocked state.
+ */
+void mutex_init(mutex_t *mutex);
+
+/**
+ * @brief Acquires a mutex, blocking while another task holds it.
+ *
+ * Waiters are served in priority order. The mutex is not recursive.
+ *
+ * @return 0 once the mutex is held, -1 if the caller already holds it or
+ *         is an interrupt handler.
+ */
+int mutex_lock(mutex_t *mutex);
+
+/**
+ * @brief Acquires a mutex only if it is free.
+ * @return 0 if the mutex is now held, -1 otherwise.
+ */
+int mutex_trylock(mutex_t *mutex);
+
+/**
+ * @brief Releases a mutex.
+ *
+ * Ownership passes directly to the most urgent waiter, if any, and the
+ * caller's priority falls back to what its remaining mutexes require.
+ *
+ * @return 0 on success, -1 if the caller does not hold the mutex.
+ */
+int mutex_unlock(mutex_t *mutex);
+
+#endif /* KUMOTRAIL_MUTEX_H */
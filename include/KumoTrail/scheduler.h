@@ -2,26 +2,67 @@
 #define KUMOTRAIL_SCHEDULER_H
 
 #include <stdint.h>
+#include "task.h"
+#include "waitqueue.h"
 
 // Define the type for a task's main function.
 typedef void (*task_func_t)(void);
 
+/**
+ * @brief Declares a task whose TCB and stack are allocated at link time.
+ *
+ * The TCB is placed in the .kumotrail.tasks section and the stack in
+ * .kumotrail.stacks; scheduler_init() walks the task section and makes
+ * every declared task ready. Use at file scope.
+ *
+ * @param name Name of the task_t object.
+ * @param func Task function. Must never return.
+ * @param prio Task priority, 0 (most urgent) to KERNEL_IDLE_PRIORITY - 1.
+ * @param stack_bytes Stack size in bytes, a multiple of 16.
+ */
+#define TASK_DEFINE(name, func, prio, stack_bytes) \
+    _Static_assert((stack_bytes) % 16 == 0, #name ": stack size must be a multiple of 16"); \
+    static uint32_t name##_stack[(stack_bytes) / sizeof(uint32_t)] \
+        __attribute__((aligned(16), section(".kumotrail.stacks"))); \
+    task_t name __attribute__((used, section(".kumotrail.tasks"))) = { \
+        .state = TASK_UNUSED, \
+        .priority = (prio), \
+        .entry = (func), \
+        .stack_base = name##_stack, \
+        .stack_size = (stack_bytes), \
+    }
+
 /**
  * @brief Initializes the task scheduler.
  *
  * Sets up the initial task structures and prepares the scheduler to run.
- * Must be called once before creating any tasks.
+ * Must be called once before creating any tasks. Every task declared with
+ * TASK_DEFINE(), including the kernel idle task, is made ready here.
  */
 void scheduler_init(void);
 
 /**
  * @brief Creates a new task and adds it to the scheduler.
  *
+ * The task runs at KERNEL_DEFAULT_PRIORITY. Its TCB and a stack of
+ * KERNEL_TASK_STACK_SIZE bytes come from a pool of KERNEL_MAX_TASKS
+ * entries that is itself part of the static task table.
+ *
  * @param func A pointer to the function that the task will execute.
  * @return 0 on success, -1 on failure (e.g., max tasks reached).
  */
 int task_create(task_func_t func);
 
+/**
+ * @brief Creates a new task with an explicit priority.
+ *
+ * @param func A pointer to the function that the task will execute.
+ *             Task functions must never return.
+ * @param priority Task priority, 0 (most urgent) to KERNEL_IDLE_PRIORITY - 1.
+ * @return 0 on success, -1 on failure (bad priority or max tasks reached).
+ */
+int task_create_with_priority(task_func_t func, uint8_t priority);
+
 /**
  * @brief Starts the multitasking scheduler.
  *
@@ -30,4 +71,254 @@ int task_create(task_func_t func);
  */
 void scheduler_start(void);
 
-#endif /* KUMOTRAIL_SCHEDULER_H */
\ No newline at end of file
+/**
+ * @brief Gives the CPU to the next ready task of the same priority.
+ *
+ * The switch happens in the trap path right away, through a software
+ * interrupt, rather than at the next tick. Returns immediately when no
+ * other task of the caller's priority is ready. Call from task context.
+ */
+void task_yield(void);
+
+/**
+ * @brief Keeps the calling task on the CPU until scheduler_unlock().
+ *
+ * Interrupts stay enabled and their handlers still run, but a switch they
+ * request is deferred until the outermost scheduler_unlock(). Use it for
+ * task-only shared state instead of masking interrupts. Calls nest. The
+ * task must not block while the scheduler is locked.
+ */
+void scheduler_lock(void);
+
+/**
+ * @brief Ends a scheduler_lock() section.
+ *
+ * The outermost call performs any switch that was deferred.
+ */
+void scheduler_unlock(void);
+
+/**
+ * @brief Blocks the calling task for at least the given time.
+ *
+ * The time is rounded up to whole ticks, plus one for the tick that is
+ * already under way, so the task may sleep up to one tick longer.
+ * Sleeping tasks are kept in a delta-ordered list, so each tick only
+ * touches the head of that list. Call from task context.
+ *
+ * @param ms Milliseconds to sleep. 0 returns immediately.
+ */
+void task_sleep_ms(uint32_t ms);
+
+/**
+ * @brief Blocks the calling task until a fixed period after its last wakeup.
+ *
+ * For periodic loops without cumulative drift: *wake_tick is advanced by
+ * exactly period_ticks on every call, however late the caller was. Seed it
+ * with scheduler_get_ticks() before the loop; use KERNEL_MS_TO_TICKS() to
+ * convert a period in milliseconds.
+ *
+ * @param wake_tick Tick of the previous wakeup, updated to the new one.
+ * @param period_ticks Loop period in ticks.
+ * @return 0 if the task slept, -1 if the new wakeup tick had already
+ *         passed and the call returned immediately.
+ */
+int task_delay_until(uint32_t *wake_tick, uint32_t period_ticks);
+
+/**
+ * @brief Updates a task's notification word and wakes it if it waits on it.
+ *
+ * A notification needs no kernel object: every task has one word, which
+ * makes this the cheapest way for an ISR or task to wake one known task.
+ * Safe to call from interrupt handlers and tasks.
+ *
+ * @param task Task to notify.
+ * @param value Bits to set or value to store, depending on action.
+ * @param action TASK_NOTIFY_SET_BITS, TASK_NOTIFY_INCREMENT or
+ *               TASK_NOTIFY_OVERWRITE.
+ * @return 0 on success, -1 if task is NULL or not a live task.
+ */
+int task_notify(task_t *task, uint32_t value, task_notify_action_e action);
+
+/**
+ * @brief Waits until the calling task is notified.
+ *
+ * Returns at once if a notification arrived since the last call. Call from
+ * task context.
+ *
+ * @param clear_bits Bits of the notification word to clear on success;
+ *                   0xFFFFFFFF resets a counter or the whole word.
+ * @param value Receives the word as it was before clearing. May be NULL.
+ * @param timeout_ms Minimum wait in milliseconds before timing out (up to
+ *                   one tick more), KERNEL_NO_WAIT or KERNEL_WAIT_FOREVER.
+ * @return 0 if notified, -1 on timeout.
+ */
+int task_notify_wait(uint32_t clear_bits, uint32_t *value, uint32_t timeout_ms);
+
+/**
+ * @brief Returns the task that is currently executing.
+ * @return Pointer to the running task's TCB, or NULL before scheduler_start().
+ */
+task_t *task_current(void);
+
+/**
+ * @brief Returns the number of kernel ticks since scheduler_start().
+ */
+uint32_t scheduler_get_ticks(void);
+
+/**
+ * @brief Copies the runtime statistics of every live task.
+ *
+ * The running task's cycle and instruction counts include its current run
+ * up to the moment of the call. Interrupt handlers are charged to the task
+ * they interrupted.
+ *
+ * @param out Array receiving one entry per task.
+ * @param max Number of entries out can hold.
+ * @return Number of entries written.
+ */
+uint32_t task_stats_snapshot(task_stats_t *out, uint32_t max);
+
+/**
+ * @brief Returns the most stack a task has ever used.
+ *
+ * Stacks are painted with KERNEL_STACK_PAINT when a task is created; the
+ * scan finds the deepest word that no longer holds the pattern. The cost is
+ * proportional to the untouched part of the stack.
+ *
+ * @param task Task to measure.
+ * @return Peak stack use in bytes.
+ */
+uint32_t task_stack_high_water(const task_t *task);
+
+/**
+ * @brief Returns the most of the boot stack ever used.
+ *
+ * The boot stack runs main() and, once tasks run, interrupt handlers.
+ * @return Peak stack use in bytes.
+ */
+uint32_t kernel_stack_high_water(void);
+
+/*
+ * Kernel-internal interface
+ *
+ * The functions below are called from interrupt context by the tick source
+ * and the trap path. They are not meant for application tasks.
+ */
+
+/** Task that owns the CPU. Read and written by the trap entry/exit code. */
+extern task_t *volatile current_task;
+
+/** Non-zero when a higher-priority task is ready and a switch is due. */
+extern volatile uint32_t scheduler_switch_pending;
+
+/**
+ * @brief Returns non-zero when called by a running task, as opposed to an
+ * interrupt handler or the code before scheduler_start().
+ */
+int scheduler_in_task(void);
+
+/**
+ * @brief Asks for scheduler_switch() to run as soon as possible.
+ *
+ * Called with interrupts disabled. While the scheduler is locked and the
+ * current task is still running, the request is only recorded for
+ * scheduler_unlock(). In interrupt context this only sets
+ * scheduler_switch_pending, which the outermost trap exit acts on. From a
+ * task it also raises the yield software interrupt, so the switch happens
+ * the moment interrupts are enabled again instead of at the next tick.
+ */
+void scheduler_request_switch(void);
+
+/**
+ * @brief Blocks the current task until scheduler_wake() is called on it.
+ *
+ * Called from task context with interrupts disabled by a critical section
+ * that was entered with them enabled. Interrupts are enabled while the
+ * task is switched out and disabled again on return.
+ */
+void scheduler_block_current(void);
+
+/**
+ * @brief Blocks the current task on a wait queue, with a timeout.
+ *
+ * Called from task context with interrupts disabled, like
+ * scheduler_block_current(). The task leaves the queue when a waker passes
+ * it to scheduler_wake_waiter() or when the timeout expires, whichever
+ * comes first.
+ *
+ * @param queue Queue to wait on.
+ * @param timeout_ms Minimum wait in milliseconds before timing out (up to
+ *                   one tick more), or KERNEL_WAIT_FOREVER.
+ * @return 0 if woken by scheduler_wake_waiter(), -1 on timeout, and -1
+ *         without blocking for KERNEL_NO_WAIT or outside task context.
+ */
+int scheduler_wait(wait_queue_t *queue, uint32_t timeout_ms);
+
+/**
+ * @brief Ends a task's scheduler_wait() successfully.
+ *
+ * Called with interrupts disabled, from a task or an ISR. Whatever the
+ * waiter asked for must already be handed over, e.g. through wait_value,
+ * so it never has to compete for it again after waking.
+ */
+void scheduler_wake_waiter(task_t *task);
+
+/**
+ * @brief Advances the kernel tick, runs due software timers and applies
+ * round-robin time slicing.
+ *
+ * Must be called once per tick from interrupt context.
+ */
+void scheduler_tick(void);
+
+/**
+ * @brief Returns how many ticks the kernel can sleep without missing work.
+ *
+ * Used by the tickless idle path with interrupts disabled. Returns 0 when a
+ * task other than idle is ready, otherwise the ticks until the next kernel
+ * deadline, capped at KERNEL_TICKLESS_MAX_IDLE_TICKS.
+ */
+uint32_t scheduler_idle_ticks(void);
+
+/**
+ * @brief Catches the tick count up after a tickless idle period.
+ * @param ticks Whole ticks that elapsed while the tick was suppressed.
+ */
+void scheduler_step_ticks(uint32_t ticks);
+
+/**
+ * @brief Takes a task off its ready queue and marks it TASK_BLOCKED.
+ *
+ * Called with interrupts disabled. When the task is the current one, a
+ * switch is requested and happens once interrupts are enabled again.
+ */
+void scheduler_block(task_t *task);
+
+/**
+ * @brief Makes a blocked task ready again.
+ *
+ * Called with interrupts disabled, from a task or an ISR. Requests a
+ * switch when the task is more urgent than the current one.
+ */
+void scheduler_wake(task_t *task);
+
+/**
+ * @brief Changes the effective priority of a task.
+ *
+ * Called with interrupts disabled. A ready or running task moves to the
+ * tail of its new ready queue and a blocked one is re-sorted in the wait
+ * queue it is on. Requests a switch when the current task is no longer the
+ * most urgent. base_priority is left alone, so this is what priority
+ * inheritance uses to boost and restore a task.
+ */
+void scheduler_set_priority(task_t *task, uint8_t priority);
+
+/**
+ * @brief Makes the highest-priority ready task the current task.
+ *
+ * Called on the trap exit path when scheduler_switch_pending is set, with
+ * interrupts disabled. Constant time regardless of the number of tasks.
+ */
+void scheduler_switch(void);
+
+#endif /* KUMOTRAIL_SCHEDULER_H */
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file semaphore.h
+ * @brief Counting semaphores.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Waiters are queued by priority. A give while a task waits does not touch
+ * the count: the token goes straight to the most urgent waiter, which
+ * returns from semaphore_take() without having to compete for it again.
+ */
+
+#ifndef KUMOTRAIL_SEMAPHORE_H
+#define KUMOTRAIL_SEMAPHORE_H
+
+#include <stdint.h>
+#include "waitqueue.h"
+
+/**
+ * @brief Semaphore object. Treat all fields as private.
+ */
+typedef struct semaphore {
+    uint32_t count;             // Tokens available.
+    uint32_t max_count;         // Count at which further gives fail.
+    wait_queue_t waiters;       // Tasks blocked in semaphore_take().
+} semaphore_t;
+
+/** Static initializer for a semaphore_t. */
+#define SEMAPHORE_INIT(initial, max) { .count = (initial), .max_count = (max), \
+                                       .waiters = WAIT_QUEUE_INIT }
+
+/**
+ * @brief Prepares a semaphore.
+ * @param sem Semaphore to initialize.
+ * @param initial Tokens available at start.
+ * @param max_count Highest count, 1 for a binary semaphore.
+ */
+void semaphore_init(semaphore_t *sem, uint32_t initial, uint32_t max_count);
+
+/**
+ * @brief Takes a token, blocking until one is available.
+ *
+ * Call from task context; interrupt handlers may only use KERNEL_NO_WAIT.
+ *
+ * @param sem Semaphore to take from.
+ * @param timeout_ms Minimum wait in milliseconds before timing out (up to
+ *                   one tick more), KERNEL_NO_WAIT or KERNEL_WAIT_FOREVER.
+ * @return 0 if a token was taken, -1 on timeout.
+ */
+int semaphore_take(semaphore_t *sem, uint32_t timeout_ms);
+
+/**
+ * @brief Releases a token, handing it to the most urgent waiter if any.
+ *
+ * Safe to call from interrupt handlers and tasks. From a handler, a switch
+ * to a woken task happens on the outermost trap exit.
+ *
+ * @return 0 on success, -1 if the count is already at its maximum.
+ */
+int semaphore_give(semaphore_t *sem);
+
+/**
+ * @brief Returns the number of tokens available.
+ */
+uint32_t semaphore_count(const semaphore_t *sem);
+
+#endif /* KUMOTRAIL_SEMAPHORE_H */
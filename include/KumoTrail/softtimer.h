@@ -0,0 +1,114 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KUMOTRAIL_SOFTTIMER_H
+#define KUMOTRAIL_SOFTTIMER_H
+
+/**
+ * @file softtimer.h
+ * @brief One-shot and periodic software timers driven by the kernel tick.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Timers are kept in a hierarchical timing wheel, so starting and stopping
+ * a timer is O(1) and each tick only looks at the timers that are due.
+ * Timer objects are owned by the caller; no memory is allocated.
+ *
+ * Callbacks run from the tick interrupt with interrupts disabled and must
+ * be short. They may start or stop any timer, including their own.
+ */
+
+#include <stdint.h>
+
+/** Number of wheel levels. Each level has 32 slots. */
+#define SOFTTIMER_LEVELS        5
+
+/** Longest delay or period, in ticks (2^25 - 1, about 93 hours at 100 Hz). */
+#define SOFTTIMER_MAX_TICKS     ((1U << (SOFTTIMER_LEVELS * 5U)) - 1U)
+
+/** Software timer callback. */
+typedef void (*softtimer_func_t)(void *arg);
+
+/**
+ * @brief Software timer object. Treat all fields as private.
+ */
+typedef struct softtimer {
+    struct softtimer *next;     // Next timer in the same wheel slot.
+    struct softtimer **pprev;   // Link pointing at this timer, NULL if idle.
+    uint32_t expires;           // Wheel tick at which the timer fires.
+    uint32_t period;            // Reload period in ticks, 0 for one-shot.
+    softtimer_func_t callback;
+    void *arg;
+    uint8_t level;              // Wheel level holding the timer.
+    uint8_t slot;               // Slot within that level.
+} softtimer_t;
+
+/**
+ * @brief Prepares a timer object. Must be called before any other use.
+ * @param timer Timer to initialize.
+ * @param callback Function called on expiry.
+ * @param arg Argument passed to the callback.
+ */
+void softtimer_init(softtimer_t *timer, softtimer_func_t callback, void *arg);
+
+/**
+ * @brief Arms a timer, restarting it if it is already running.
+ *
+ * @param timer Timer to arm.
+ * @param delay_ticks Ticks until the first expiry (0 is treated as 1).
+ * @param period_ticks Reload period in ticks, or 0 for a one-shot timer.
+ *                     Periodic timers are reloaded from their previous
+ *                     deadline, so they do not drift.
+ */
+void softtimer_start(softtimer_t *timer, uint32_t delay_ticks, uint32_t period_ticks);
+
+/**
+ * @brief Cancels a timer. Does nothing if the timer is not running.
+ */
+void softtimer_stop(softtimer_t *timer);
+
+/**
+ * @brief Returns non-zero while the timer is armed.
+ */
+int softtimer_is_active(const softtimer_t *timer);
+
+/*
+ * Kernel-internal interface, driven by the scheduler tick.
+ */
+
+/**
+ * @brief Advances the wheel by one tick and runs the timers that expire.
+ */
+void softtimer_tick(void);
+
+/**
+ * @brief Advances the wheel by several ticks, running the timers that expire.
+ *
+ * Equivalent to calling softtimer_tick() 'ticks' times, but the ticks
+ * before the next deadline cost nothing, so catching up after a tickless
+ * sleep up to that deadline takes a single wheel step.
+ */
+void softtimer_advance(uint32_t ticks);
+
+/**
+ * @brief Returns a lower bound on the ticks until the wheel has work to do.
+ *
+ * Used by tickless idle. Returns SOFTTIMER_MAX_TICKS when no timer is armed.
+ */
+uint32_t softtimer_ticks_to_next(void);
+
+#endif /* KUMOTRAIL_SOFTTIMER_H */
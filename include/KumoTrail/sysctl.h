@@ -82,4 +82,20 @@ void sysctl_enable_clock(peripheral_t peripheral);
  */
 void sysctl_reset_peripheral(peripheral_t peripheral);
 
+/**
+ * @brief Raises a software interrupt.
+ *
+ * Asserts interrupt matrix source FROM_CPU_INTRn. It stays asserted until
+ * sysctl_cpu_intr_clear() is called, normally by its handler.
+ *
+ * @param n Software interrupt number, 0 to 3.
+ */
+void sysctl_cpu_intr_set(uint32_t n);
+
+/**
+ * @brief Lowers a software interrupt.
+ * @param n Software interrupt number, 0 to 3.
+ */
+void sysctl_cpu_intr_clear(uint32_t n);
+
 #endif /* __KUMOTRAIL_SYSCTL_H__ */
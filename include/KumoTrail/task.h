@@ -24,25 +24,95 @@
 
 #include<stdint.h>
 
+struct wait_queue;
+struct mutex;
+
 /*
  * @brief Enumeration of task states.
  */
 
 typedef enum
 {
-    TASK_UNUSED, // The TCB is free and can be used for a new task.
-    TASK_READY,  // The task is ready to run but not currently running.
-    TASK_RUNNING // The task is currently executing.
+    TASK_UNUSED,  // The TCB is free and can be used for a new task.
+    TASK_READY,   // The task is ready to run but not currently running.
+    TASK_RUNNING, // The task is currently executing.
+    TASK_BLOCKED, // The task waits for an event and is in no ready queue.
+    TASK_EXITED   // The task returned; the TCB is freed once switched away from.
 } task_state_e;
 
+/*
+ * @brief State of a task's notification word.
+ */
+
+typedef enum
+{
+    TASK_NOTIFY_IDLE,    // No notification since the last task_notify_wait().
+    TASK_NOTIFY_WAITING, // Blocked in task_notify_wait().
+    TASK_NOTIFY_PENDING  // Notified; the next task_notify_wait() returns at once.
+} task_notify_state_e;
+
+/*
+ * @brief How task_notify() updates the notification word.
+ */
+
+typedef enum
+{
+    TASK_NOTIFY_SET_BITS,  // OR the value into the word.
+    TASK_NOTIFY_INCREMENT, // Add one to the word; the value is ignored.
+    TASK_NOTIFY_OVERWRITE  // Replace the word with the value.
+} task_notify_action_e;
+
 /**
  * @brief Task control block structure.
+ *
+ * stack_pointer must remain the first member: the trap entry/exit code
+ * saves and restores it at offset 0.
  */
 
-typedef struct {
-    volatile uint32_t *stack_pointer;
-    task_state_e state;
-    volatile task_t *next;
+typedef struct task {
+    volatile uint32_t *stack_pointer; // Saved stack pointer while switched out.
+    task_state_e state;               // Current scheduling state.
+    uint8_t priority;                 // 0 is the most urgent priority.
+    uint8_t base_priority;            // Priority without inheritance.
+    void (*entry)(void);              // Task entry function.
+    struct task *next;                // Next task in the same ready queue.
+    struct task *prev;                // Previous task in the same ready queue.
+    struct task *sleep_next;          // Next task in the sleep list.
+    struct task **sleep_pprev;        // Link pointing at this task, NULL if awake.
+    uint32_t sleep_delta;             // Ticks after the previous sleeper expires.
+    struct wait_queue *wait_queue;    // Wait queue the task is blocked on.
+    struct task *wait_next;           // Next, less or equally urgent, waiter.
+    struct task **wait_pprev;         // Link pointing at this task, NULL if not waiting.
+    int wait_status;                  // 0 if the last wait was satisfied, -1 on timeout.
+    uint32_t wait_value;              // Word exchanged with the waker, object-specific.
+    uint32_t wait_options;            // Wait options, object-specific.
+    void *wait_data;                  // Pointer exchanged with the waker, object-specific.
+    struct mutex *waiting_mutex;      // Mutex the task is blocked on.
+    struct mutex *held_mutexes;       // Mutexes the task owns.
+    uint32_t notify_value;            // Notification word, see task_notify().
+    task_notify_state_e notify_state; // Notification state.
+    uint32_t *stack_base;             // Lowest address of the task's stack.
+    uint32_t stack_size;              // Stack size in bytes.
+
+    uint64_t cycles;                  // mcycle counts spent running.
+    uint64_t instret;                 // Instructions retired while running.
+    uint32_t voluntary_switches;      // Times it gave up the CPU itself.
+    uint32_t involuntary_switches;    // Times it was preempted.
+    uint32_t last_run_tick;           // Kernel tick it was last switched in.
 } task_t;
 
-#endif // KUMOTRAIL_TASK_H
\ No newline at end of file
+/**
+ * @brief Copy of one task's runtime statistics, see task_stats_snapshot().
+ */
+typedef struct {
+    void (*entry)(void);           // Task entry function, identifies the task.
+    uint8_t priority;              // Task priority.
+    task_state_e state;            // Scheduling state at snapshot time.
+    uint64_t cycles;               // mcycle counts spent running.
+    uint64_t instret;              // Instructions retired while running.
+    uint32_t voluntary_switches;   // Times it gave up the CPU itself.
+    uint32_t involuntary_switches; // Times it was preempted.
+    uint32_t last_run_tick;        // Kernel tick it was last switched in.
+} task_stats_t;
+
+#endif // KUMOTRAIL_TASK_H
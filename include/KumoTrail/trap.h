@@ -12,9 +12,10 @@
 /**
  * @brief Initializes the trap vector.
  *
- * Sets the CPU's machine trap vector (mtvec) to point to the low-level
- * assembly trap handler. This must be called once before interrupts
- * are enabled.
+ * Sets the CPU's machine trap vector (mtvec) to the vector table in
+ * vectored mode, so each interrupt line enters through its own stub and
+ * exceptions through the low-level assembly trap handler. This must be
+ * called once before interrupts are enabled.
  */
 void trap_init(void);
 
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file waitqueue.h
+ * @brief Priority-ordered queues of tasks blocked on a kernel object.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Kernel-internal building block for the synchronisation objects. The head
+ * of a queue is always its most urgent waiter; waiters of equal priority
+ * are kept in arrival order. All functions must be called with interrupts
+ * disabled.
+ */
+
+#ifndef KUMOTRAIL_WAITQUEUE_H
+#define KUMOTRAIL_WAITQUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "task.h"
+
+/**
+ * @brief Queue of blocked tasks. Treat all fields as private.
+ */
+typedef struct wait_queue {
+    task_t *head;               // Most urgent waiter, NULL when empty.
+} wait_queue_t;
+
+/** Static initializer for a wait_queue_t. */
+#define WAIT_QUEUE_INIT { .head = NULL }
+
+/**
+ * @brief Empties a wait queue.
+ */
+void wait_queue_init(wait_queue_t *queue);
+
+/**
+ * @brief Adds a task behind every waiter at least as urgent as itself.
+ * @param queue Queue to join.
+ * @param task Task to add. Must not be on any wait queue.
+ */
+void wait_queue_insert(wait_queue_t *queue, task_t *task);
+
+/**
+ * @brief Takes a task off the wait queue it is on, if any.
+ */
+void wait_queue_remove(task_t *task);
+
+/**
+ * @brief Removes and returns the most urgent waiter.
+ * @return The former head, or NULL if the queue is empty.
+ */
+task_t *wait_queue_pop(wait_queue_t *queue);
+
+/**
+ * @brief Returns the most urgent waiter without removing it.
+ */
+static inline task_t *wait_queue_peek(const wait_queue_t *queue)
+{
+    return queue->head;
+}
+
+#endif /* KUMOTRAIL_WAITQUEUE_H */
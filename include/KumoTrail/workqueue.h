@@ -0,0 +1,50 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file workqueue.h
+ * @brief Deferred work: run interrupt follow-up work in a kernel task.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ */
+
+#ifndef KUMOTRAIL_WORKQUEUE_H
+#define KUMOTRAIL_WORKQUEUE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Deferred work function, called with the argument given to
+ * workqueue_defer().
+ */
+typedef void (*work_func_t)(void *arg);
+
+/**
+ * @brief Queues fn(arg) to run in the worker task.
+ *
+ * The worker is a TASK_DEFINE() task at KERNEL_WORKQUEUE_PRIORITY, so it
+ * exists as soon as scheduler_init() has run.
+ * Safe to call from interrupt handlers and tasks. Items run in the order
+ * they were queued, with interrupts enabled.
+ *
+ * @param fn Function to run.
+ * @param arg Argument passed to fn.
+ * @return 0 on success, -1 if fn is NULL or the queue is full.
+ */
+int workqueue_defer(work_func_t fn, void *arg);
+
+#endif /* KUMOTRAIL_WORKQUEUE_H */
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file eventgroup.c
+ * @brief Event flag groups with selective wakeup.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * A waiting task keeps its requested flags in wait_value and its options in
+ * wait_options. When it is woken, wait_value is overwritten with the flags
+ * that satisfied it.
+ */
+
+#include "eventgroup.h"
+#include "scheduler.h"
+#include "waitqueue.h"
+#include "kernel.h"
+#include "irq.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Non-zero if 'flags' satisfies a wait for 'bits' with 'options'.
+ */
+static int event_group_satisfied(uint32_t flags, uint32_t bits, uint32_t options)
+{
+    if (options & EVENT_WAIT_ALL) {
+        return (flags & bits) == bits;
+    }
+    return (flags & bits) != 0;
+}
+
+void event_group_init(event_group_t *group)
+{
+    group->flags = 0;
+    wait_queue_init(&group->waiters);
+}
+
+uint32_t event_group_set(event_group_t *group, uint32_t bits)
+{
+    uint32_t irq = irq_save();
+    uint32_t consumed = 0;
+    task_t *next;
+
+    group->flags |= bits;
+    for (task_t *task = wait_queue_peek(&group->waiters); task; task = next) {
+        next = task->wait_next;
+
+        if (!event_group_satisfied(group->flags, task->wait_value, task->wait_options)) {
+            continue;
+        }
+        if (task->wait_options & EVENT_CLEAR_ON_EXIT) {
+            consumed |= task->wait_value;
+        }
+        task->wait_value = group->flags;
+        scheduler_wake_waiter(task);
+    }
+    group->flags &= ~consumed;
+
+    uint32_t flags = group->flags;
+    irq_restore(irq);
+    return flags;
+}
+
+uint32_t event_group_clear(event_group_t *group, uint32_t bits)
+{
+    uint32_t irq = irq_save();
+    uint32_t flags = group->flags;
+
+    group->flags = flags & ~bits;
+
+    irq_restore(irq);
+    return flags;
+}
+
+uint32_t event_group_get(const event_group_t *group)
+{
+    return group->flags;
+}
+
+uint32_t event_group_wait(event_group_t *group, uint32_t bits, uint32_t options,
+                          uint32_t timeout_ms)
+{
+    if (!bits) {
+        return 0;
+    }
+
+    uint32_t irq = irq_save();
+    uint32_t flags = group->flags;
+
+    if (event_group_satisfied(flags, bits, options)) {
+        if (options & EVENT_CLEAR_ON_EXIT) {
+            group->flags = flags & ~bits;
+        }
+    } else if (scheduler_in_task() && timeout_ms != KERNEL_NO_WAIT) {
+        current_task->wait_value = bits;
+        current_task->wait_options = options;
+        // event_group_set() stores the satisfying flags and does the clear.
+        flags = scheduler_wait(&group->waiters, timeout_ms) == 0 ? current_task->wait_value : 0;
+    } else {
+        flags = 0;
+    }
+
+    irq_restore(irq);
+    return flags;
+}
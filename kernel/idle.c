@@ -0,0 +1,167 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file idle.c
+ * @brief Kernel idle task with wfi sleep and CPU load accounting.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Idle time is the time the core spends inside wfi, measured on the TIMG1
+ * timebase. mcycle cannot be used for this: the core clock is gated while
+ * it waits, so mcycle stops exactly during the time we want to count.
+ *
+ * The time is accumulated into fixed sample periods kept in a small ring.
+ * The load is busy time over wall time across the ring plus the open period,
+ * so the figure follows the last KERNEL_LOAD_WINDOW periods.
+ */
+
+#include "idle.h"
+#include "scheduler.h"
+#include "kernel.h"
+#include "timer.h"
+#include "irq.h"
+#include <stdint.h>
+
+#define LOAD_SAMPLE_COUNTS ((TIMER_TIMEBASE_HZ / 1000U) * KERNEL_LOAD_SAMPLE_MS)
+#define LOAD_WINDOW_COUNTS (LOAD_SAMPLE_COUNTS * KERNEL_LOAD_WINDOW)
+
+typedef struct {
+    uint32_t idle;  // Timebase counts spent in wfi.
+    uint32_t total; // Length of the period in timebase counts.
+} load_sample_t;
+
+static load_sample_t load_window[KERNEL_LOAD_WINDOW];
+static uint32_t load_index = 0;
+
+/** Start of the open sample period and the idle time gathered in it. */
+static uint64_t load_period_start = 0;
+static uint32_t load_period_idle = 0;
+
+TASK_DEFINE(idle_tcb, idle_task, KERNEL_IDLE_PRIORITY, KERNEL_IDLE_STACK_SIZE);
+
+static uint64_t idle_now(void)
+{
+    return timer_now_ticks64();
+}
+
+/**
+ * @brief Length of the open period, scaled down together with *idle to at
+ * most the window length.
+ *
+ * The period stays open for as long as the idle task does not run, which
+ * can be far longer than 32 bits of timebase counts. Halving both figures
+ * keeps the idle ratio while bounding the period's weight in the window.
+ */
+static uint32_t load_open_total(uint64_t now, uint32_t *idle)
+{
+    uint64_t total = now - load_period_start;
+
+    while (total > LOAD_WINDOW_COUNTS) {
+        total >>= 1;
+        *idle >>= 1;
+    }
+    return (uint32_t)total;
+}
+
+/**
+ * @brief Close the open period once it is long enough. Interrupts must be
+ * disabled.
+ */
+static void load_roll(uint64_t now)
+{
+    uint32_t idle = load_period_idle;
+    uint32_t total = load_open_total(now, &idle);
+
+    if (total < LOAD_SAMPLE_COUNTS) {
+        return;
+    }
+    load_window[load_index].idle = idle;
+    load_window[load_index].total = total;
+    load_index = (load_index + 1U) % KERNEL_LOAD_WINDOW;
+    load_period_start = now;
+    load_period_idle = 0;
+}
+
+uint32_t idle_cpu_load(void)
+{
+    uint32_t irq = irq_save();
+    uint64_t now = idle_now();
+
+    load_roll(now);
+
+    uint32_t idle = load_period_idle;
+    uint32_t total = load_open_total(now, &idle);
+
+    for (uint32_t i = 0; i < KERNEL_LOAD_WINDOW; i++) {
+        idle += load_window[i].idle;
+        total += load_window[i].total;
+    }
+
+    irq_restore(irq);
+
+    // Keep idle * 100 within 32 bits; there is no 64-bit divide.
+    while (total > 0xFFFFFFFFU / 100U) {
+        idle >>= 1;
+        total >>= 1;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    return 100U - (idle * 100U) / total;
+}
+
+/**
+ * With KERNEL_TICKLESS_IDLE the periodic tick is stopped until the next
+ * kernel deadline while the core waits. Interrupts stay masked from the
+ * deadline check until the tick count has been caught up, so a wakeup can
+ * never observe a stale tick count; wfi still returns on a pending
+ * interrupt, which is then taken once MIE is restored. Handler time is
+ * therefore never counted as idle.
+ */
+void idle_task(void)
+{
+    irq_disable();
+    load_period_start = idle_now();
+    irq_enable();
+
+    while (1)
+    {
+        irq_disable();
+
+        uint64_t start = idle_now();
+#if KERNEL_TICKLESS_IDLE
+        uint32_t idle_ticks = scheduler_idle_ticks();
+        if (idle_ticks >= KERNEL_TICKLESS_MIN_IDLE_TICKS &&
+            timer_suppress_ticks(idle_ticks) == 0) {
+            asm volatile ("wfi");
+            scheduler_step_ticks(timer_resume_ticks());
+        } else {
+            asm volatile ("wfi");
+        }
+#else
+        asm volatile ("wfi");
+#endif
+        uint64_t end = idle_now();
+
+        // A single wait is bounded by the longest tickless sleep.
+        load_period_idle += (uint32_t)(end - start);
+        load_roll(end);
+
+        irq_enable();
+    }
+}
@@ -24,7 +24,11 @@
  */
 
 #include "interrupt.h"
+#include "uart.h"
+#include "irq.h"
+#include "bitops.h"
 #include <stdint.h>
+#include <stddef.h>
 
 /**
  * @brief Base address for the interrupt matrix hardware.
@@ -37,12 +41,338 @@
 #define INTERRUPT_SOURCE_MAP_REG(source) \
     (*(volatile uint32_t*)(INTERRUPT_MATRIX_BASE_ADDR + ((source) * 4)))
 
+/**
+ * @brief Raw status of sources 0-31 and 32-61, one bit per source.
+ */
+#define INTERRUPT_CORE0_INTR_STATUS_REG(word) \
+    (*(volatile uint32_t*)(INTERRUPT_MATRIX_BASE_ADDR + 0x00F8 + ((word) * 4)))
+
 /**
  * @brief Register for enabling CPU interrupt lines.
  */
 #define INTERRUPT_CORE0_CPU_INT_ENABLE_REG \
     (*(volatile uint32_t*)(INTERRUPT_MATRIX_BASE_ADDR + 0x0104))
 
+/**
+ * @brief Register selecting edge (1) or level (0) triggering per CPU line.
+ */
+#define INTERRUPT_CORE0_CPU_INT_TYPE_REG \
+    (*(volatile uint32_t*)(INTERRUPT_MATRIX_BASE_ADDR + 0x0108))
+
+/**
+ * @brief Register for acknowledging edge-triggered CPU lines.
+ */
+#define INTERRUPT_CORE0_CPU_INT_CLEAR_REG \
+    (*(volatile uint32_t*)(INTERRUPT_MATRIX_BASE_ADDR + 0x010C))
+
+/**
+ * @brief Macro to access the priority register of a CPU line.
+ */
+#define INTERRUPT_CORE0_CPU_INT_PRI_REG(cpu_line) \
+    (*(volatile uint32_t*)(INTERRUPT_MATRIX_BASE_ADDR + 0x0114 + ((cpu_line) * 4)))
+
+/**
+ * @brief Register holding the CPU priority threshold.
+ */
+#define INTERRUPT_CORE0_CPU_INT_THRESH_REG \
+    (*(volatile uint32_t*)(INTERRUPT_MATRIX_BASE_ADDR + 0x0194))
+
+/**
+ * @brief Handler table entry for one CPU interrupt line.
+ */
+typedef struct {
+    interrupt_handler_t handler;
+    void *arg;
+} interrupt_entry_t;
+
+static void interrupt_unhandled(void *arg);
+
+/**
+ * @brief Handler table indexed by CPU line (the mcause interrupt number).
+ *
+ * Every entry always holds a callable handler, so dispatch is a single
+ * indexed load and call with no compare chain and no NULL check.
+ */
+static interrupt_entry_t interrupt_table[INTERRUPT_LINE_COUNT] = {
+    [0 ... INTERRUPT_LINE_COUNT - 1] = { interrupt_unhandled, NULL }
+};
+
+/**
+ * @brief Source-to-line ownership table.
+ *
+ * Sources that fire often or need low latency own a dedicated line. An
+ * entry of 0 means the source shares INTERRUPT_LINE_SHARED and pays for a
+ * status register scan.
+ */
+static const uint8_t interrupt_routing[INTERRUPT_SOURCE_MAX] = {
+    [INTERRUPT_SOURCE_TIMG0_T0]       = INTERRUPT_LINE_TIMER,
+    [INTERRUPT_SOURCE_UART0]          = INTERRUPT_LINE_UART0,
+    [INTERRUPT_SOURCE_GPIO]           = INTERRUPT_LINE_GPIO,
+    [INTERRUPT_SOURCE_SPI2]           = INTERRUPT_LINE_SPI2,
+    [INTERRUPT_SOURCE_DMA_CH0]        = INTERRUPT_LINE_DMA_CH0,
+    [INTERRUPT_SOURCE_DMA_CH1]        = INTERRUPT_LINE_DMA_CH1,
+    [INTERRUPT_SOURCE_DMA_CH2]        = INTERRUPT_LINE_DMA_CH2,
+    [INTERRUPT_SOURCE_FROM_CPU_INTR0] = INTERRUPT_LINE_YIELD,
+};
+
+/**
+ * @brief Handlers of the sources attached to the shared line.
+ */
+static interrupt_entry_t interrupt_shared_table[INTERRUPT_SOURCE_MAX];
+
+/**
+ * @brief Attached shared sources, in INTR_STATUS_0/1 bit layout.
+ */
+static uint32_t interrupt_shared_mask[2];
+
+/**
+ * @brief Shadow copies of the line priorities and edge-type bits, so the
+ * dispatch path does not have to read them back from the matrix.
+ */
+static uint8_t interrupt_priority[INTERRUPT_LINE_COUNT];
+static uint32_t interrupt_edge_mask;
+
+/**
+ * @brief Default handler for lines nobody registered.
+ */
+static void interrupt_unhandled(void *arg)
+{
+    (void)arg;
+    uart_puts("Unknown interrupt occurred\n");
+}
+
+/**
+ * @brief Handler of the shared line: run every attached source whose
+ * status bit is set, lowest source number first.
+ */
+static void interrupt_shared_dispatch(void *arg)
+{
+    (void)arg;
+
+    for (uint32_t word = 0; word < 2; word++) {
+        uint32_t pending = INTERRUPT_CORE0_INTR_STATUS_REG(word) & interrupt_shared_mask[word];
+
+        while (pending) {
+            uint32_t bit = bitops_ctz32(pending);
+            const interrupt_entry_t *entry = &interrupt_shared_table[word * 32U + bit];
+
+            pending &= pending - 1U;
+
+            // Handlers run with MIE set, so an earlier one or a nested
+            // interrupt may have detached this source since 'pending' was
+            // read. Take the entry as one consistent pair.
+            uint32_t irq = irq_save();
+            interrupt_handler_t handler = entry->handler;
+            void *handler_arg = entry->arg;
+            irq_restore(irq);
+
+            if (handler) {
+                handler(handler_arg);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Register the handler for a CPU interrupt line.
+ * @param cpu_line CPU interrupt line (1-31).
+ * @param handler Function to call, or NULL to restore the default handler.
+ * @param arg Argument passed to the handler.
+ * @return 0 on success, -1 if the line is out of range.
+ */
+int interrupt_register_handler(int cpu_line, interrupt_handler_t handler, void *arg)
+{
+    if (cpu_line <= 0 || cpu_line >= INTERRUPT_LINE_COUNT) {
+        return -1;
+    }
+    if (!handler) {
+        handler = interrupt_unhandled;
+        arg = NULL;
+    }
+
+    // The line may fire between the two stores; keep it off meanwhile.
+    uint32_t enabled = INTERRUPT_CORE0_CPU_INT_ENABLE_REG & (1U << cpu_line);
+    interrupt_disable(cpu_line);
+    interrupt_table[cpu_line].handler = handler;
+    interrupt_table[cpu_line].arg = arg;
+    if (enabled) {
+        interrupt_enable(cpu_line);
+    }
+    return 0;
+}
+
+/**
+ * @brief Run the handler registered for a CPU interrupt line.
+ *
+ * Entered with MIE clear. The threshold is raised to one above the line's
+ * priority before MIE is set again, so only more urgent lines can preempt
+ * the handler. The trap frame already holds mepc and mstatus, so a nested
+ * trap cannot lose the outer return state.
+ *
+ * @param cpu_line CPU interrupt line that fired.
+ */
+void interrupt_dispatch(uint32_t cpu_line)
+{
+    cpu_line &= INTERRUPT_LINE_COUNT - 1;
+
+    const interrupt_entry_t *entry = &interrupt_table[cpu_line];
+    uint32_t priority = interrupt_priority[cpu_line];
+
+    if (interrupt_edge_mask & (1U << cpu_line)) {
+        INTERRUPT_CORE0_CPU_INT_CLEAR_REG |= (1U << cpu_line);
+        INTERRUPT_CORE0_CPU_INT_CLEAR_REG &= ~(1U << cpu_line);
+    }
+
+    // Nothing can preempt the top priority, so skip the threshold dance.
+    if (priority >= INTERRUPT_PRIORITY_MAX) {
+        entry->handler(entry->arg);
+        return;
+    }
+
+    uint32_t threshold = INTERRUPT_CORE0_CPU_INT_THRESH_REG;
+
+    INTERRUPT_CORE0_CPU_INT_THRESH_REG = priority + 1U;
+    // The new threshold must reach the matrix before MIE opens the window.
+    asm volatile ("fence" : : : "memory");
+    irq_enable();
+
+    entry->handler(entry->arg);
+
+    irq_disable();
+    INTERRUPT_CORE0_CPU_INT_THRESH_REG = threshold;
+}
+
+/**
+ * @brief Set the priority of a CPU interrupt line.
+ * @param cpu_line CPU interrupt line (1-31).
+ * @param priority 0 (never fires) to INTERRUPT_PRIORITY_MAX.
+ * @return 0 on success, -1 if the line or priority is out of range.
+ */
+int interrupt_set_priority(int cpu_line, uint32_t priority)
+{
+    if (cpu_line <= 0 || cpu_line >= INTERRUPT_LINE_COUNT ||
+        priority > INTERRUPT_PRIORITY_MAX) {
+        return -1;
+    }
+
+    uint32_t irq = irq_save();
+    interrupt_priority[cpu_line] = (uint8_t)priority;
+    INTERRUPT_CORE0_CPU_INT_PRI_REG(cpu_line) = priority;
+    irq_restore(irq);
+    return 0;
+}
+
+/**
+ * @brief Set the trigger type of a CPU interrupt line.
+ * @param cpu_line CPU interrupt line (1-31).
+ * @param type Level or edge triggered.
+ * @return 0 on success, -1 if the line is out of range.
+ */
+int interrupt_set_type(int cpu_line, interrupt_type_t type)
+{
+    if (cpu_line <= 0 || cpu_line >= INTERRUPT_LINE_COUNT) {
+        return -1;
+    }
+
+    uint32_t irq = irq_save();
+    if (type == INTERRUPT_TYPE_EDGE) {
+        interrupt_edge_mask |= (1U << cpu_line);
+    } else {
+        interrupt_edge_mask &= ~(1U << cpu_line);
+    }
+    INTERRUPT_CORE0_CPU_INT_TYPE_REG = interrupt_edge_mask;
+    irq_restore(irq);
+    return 0;
+}
+
+/**
+ * @brief Set the CPU priority threshold.
+ * @param threshold New threshold, INTERRUPT_PRIORITY_MIN to INTERRUPT_PRIORITY_MAX.
+ */
+void interrupt_set_threshold(uint32_t threshold)
+{
+    INTERRUPT_CORE0_CPU_INT_THRESH_REG = threshold;
+}
+
+/**
+ * @brief Attach a handler to a hardware interrupt source.
+ * @param source Hardware interrupt source.
+ * @param handler Function to call when the source fires.
+ * @param arg Argument passed to the handler.
+ * @return 0 on success, -1 if the source is out of range or handler is NULL.
+ */
+int interrupt_attach(interrupt_source_t source, interrupt_handler_t handler, void *arg)
+{
+    if ((uint32_t)source >= INTERRUPT_SOURCE_MAX || !handler) {
+        return -1;
+    }
+
+    int cpu_line = interrupt_source_line(source);
+
+    if (cpu_line != INTERRUPT_LINE_SHARED) {
+        interrupt_register_handler(cpu_line, handler, arg);
+        interrupt_route(source, cpu_line);
+        interrupt_enable(cpu_line);
+        return 0;
+    }
+
+    uint32_t irq = irq_save();
+
+    if (!(interrupt_shared_mask[0] | interrupt_shared_mask[1])) {
+        interrupt_register_handler(INTERRUPT_LINE_SHARED, interrupt_shared_dispatch, NULL);
+        interrupt_set_type(INTERRUPT_LINE_SHARED, INTERRUPT_TYPE_LEVEL);
+        interrupt_set_priority(INTERRUPT_LINE_SHARED, INTERRUPT_PRIORITY_SHARED);
+    }
+    interrupt_shared_table[source].handler = handler;
+    interrupt_shared_table[source].arg = arg;
+    interrupt_shared_mask[source / 32U] |= (1U << (source % 32U));
+    interrupt_route(source, INTERRUPT_LINE_SHARED);
+    interrupt_enable(INTERRUPT_LINE_SHARED);
+
+    irq_restore(irq);
+    return 0;
+}
+
+/**
+ * @brief Detach the handler of a hardware interrupt source.
+ * @param source Hardware interrupt source.
+ */
+void interrupt_detach(interrupt_source_t source)
+{
+    if ((uint32_t)source >= INTERRUPT_SOURCE_MAX) {
+        return;
+    }
+
+    int cpu_line = interrupt_source_line(source);
+
+    // Line 0 is never enabled, so mapping a source there silences it.
+    interrupt_route(source, 0);
+    if (cpu_line != INTERRUPT_LINE_SHARED) {
+        interrupt_disable(cpu_line);
+        interrupt_register_handler(cpu_line, NULL, NULL);
+        return;
+    }
+
+    uint32_t irq = irq_save();
+    interrupt_shared_mask[source / 32U] &= ~(1U << (source % 32U));
+    interrupt_shared_table[source].handler = NULL;
+    interrupt_shared_table[source].arg = NULL;
+    irq_restore(irq);
+}
+
+/**
+ * @brief Returns the CPU line a source owns in the routing table.
+ * @param source Hardware interrupt source.
+ * @return CPU interrupt line, or 0 if the source is out of range.
+ */
+int interrupt_source_line(interrupt_source_t source)
+{
+    if ((uint32_t)source >= INTERRUPT_SOURCE_MAX) {
+        return 0;
+    }
+    return interrupt_routing[source] ? interrupt_routing[source] : INTERRUPT_LINE_SHARED;
+}
+
 /**
  * @brief Route a hardware interrupt source to a CPU interrupt line.
  * @param source Hardware interrupt source.
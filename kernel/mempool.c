@@ -0,0 +1,71 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mempool.c
+ * @brief Fixed-size block pools.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Blocks are handed out from the end of the used region until the storage
+ * is exhausted and from the free list after that, so a pool needs no
+ * initialization pass over its storage.
+ */
+
+#include "mempool.h"
+#include "irq.h"
+#include <stdint.h>
+#include <stddef.h>
+
+void mempool_init(mempool_t *pool, void *storage, uint32_t size, uint32_t count)
+{
+    pool->storage = storage;
+    pool->block_size = MEMPOOL_BLOCK_SIZE(size);
+    pool->block_count = count;
+    pool->untouched = 0;
+    pool->free_list = NULL;
+}
+
+void *mempool_alloc(mempool_t *pool)
+{
+    uint32_t irq = irq_save();
+    void *block = pool->free_list;
+
+    if (block) {
+        pool->free_list = *(void **)block;
+    } else if (pool->untouched < pool->block_count) {
+        block = &pool->storage[pool->untouched * pool->block_size];
+        pool->untouched++;
+    }
+
+    irq_restore(irq);
+    return block;
+}
+
+void mempool_free(mempool_t *pool, void *block)
+{
+    if (!block) {
+        return;
+    }
+
+    uint32_t irq = irq_save();
+
+    *(void **)block = pool->free_list;
+    pool->free_list = block;
+
+    irq_restore(irq);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file msgq.c
+ * @brief Zero-copy message queues.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * A blocked sender parks its message in wait_data; a blocked receiver gets
+ * its message delivered there. Either way the waker completes the transfer
+ * before waking the waiter, so a woken task never finds the queue changed
+ * under it.
+ */
+
+#include "msgq.h"
+#include "scheduler.h"
+#include "waitqueue.h"
+#include "kernel.h"
+#include "irq.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Append a message to the ring, which must not be full.
+ */
+static void msgq_push(msgq_t *queue, void *msg)
+{
+    uint32_t tail = queue->head + queue->count;
+
+    if (tail >= queue->capacity) {
+        tail -= queue->capacity;
+    }
+    queue->ring[tail] = msg;
+    queue->count++;
+}
+
+/**
+ * @brief Remove the oldest message from the ring, which must not be empty.
+ */
+static void *msgq_pop(msgq_t *queue)
+{
+    void *msg = queue->ring[queue->head];
+
+    queue->head++;
+    if (queue->head == queue->capacity) {
+        queue->head = 0;
+    }
+    queue->count--;
+    return msg;
+}
+
+void msgq_init(msgq_t *queue, void **ring, uint32_t capacity)
+{
+    queue->ring = ring;
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->count = 0;
+    wait_queue_init(&queue->receivers);
+    wait_queue_init(&queue->senders);
+}
+
+int msgq_send(msgq_t *queue, void *msg, uint32_t timeout_ms)
+{
+    uint32_t irq = irq_save();
+    task_t *receiver = wait_queue_peek(&queue->receivers);
+    int ret = 0;
+
+    if (receiver) {
+        // A waiting receiver means the ring is empty: skip it.
+        receiver->wait_data = msg;
+        scheduler_wake_waiter(receiver);
+    } else if (queue->count < queue->capacity) {
+        msgq_push(queue, msg);
+    } else if (scheduler_in_task() && timeout_ms != KERNEL_NO_WAIT) {
+        current_task->wait_data = msg;
+        // On success msgq_receive() has taken the message from wait_data.
+        ret = scheduler_wait(&queue->senders, timeout_ms);
+    } else {
+        ret = -1;
+    }
+
+    irq_restore(irq);
+    return ret;
+}
+
+int msgq_receive(msgq_t *queue, void **msg, uint32_t timeout_ms)
+{
+    uint32_t irq = irq_save();
+    task_t *sender = wait_queue_peek(&queue->senders);
+    int ret = 0;
+
+    if (queue->count) {
+        *msg = msgq_pop(queue);
+        // Refill the freed slot from the most urgent blocked sender.
+        if (sender) {
+            msgq_push(queue, sender->wait_data);
+            scheduler_wake_waiter(sender);
+        }
+    } else if (sender) {
+        // Only possible with a zero-capacity queue.
+        *msg = sender->wait_data;
+        scheduler_wake_waiter(sender);
+    } else {
+        ret = scheduler_wait(&queue->receivers, timeout_ms);
+        if (ret == 0) {
+            *msg = current_task->wait_data;
+        }
+    }
+
+    irq_restore(irq);
+    return ret;
+}
+
+uint32_t msgq_count(const msgq_t *queue)
+{
+    return queue->count;
+}
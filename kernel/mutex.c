@@ -0,0 +1,184 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mutex.c
+ * @brief Priority-inheritance mutexes.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * The core has no atomic instructions, so the fast path is a short section
+ * with MIE cleared: one csrrci, a test of the owner and a push onto the
+ * owner's list of held mutexes. Only a contended lock enters the scheduler.
+ *
+ * Each task keeps the mutexes it owns on a list, and each wait queue is
+ * sorted by priority, so the priority a task must run at is the most urgent
+ * head waiter among its mutexes. That is only recomputed on unlock when the
+ * task was actually boosted.
+ */
+
+#include "mutex.h"
+#include "scheduler.h"
+#include "waitqueue.h"
+#include "irq.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Make a task the owner of a free mutex.
+ */
+static void mutex_take(mutex_t *mutex, task_t *task)
+{
+    mutex->owner = task;
+    mutex->held_next = task->held_mutexes;
+    if (mutex->held_next) {
+        mutex->held_next->held_pprev = &mutex->held_next;
+    }
+    mutex->held_pprev = &task->held_mutexes;
+    task->held_mutexes = mutex;
+}
+
+/**
+ * @brief Unlink a mutex from its owner's list and leave it free.
+ */
+static void mutex_drop(mutex_t *mutex)
+{
+    *mutex->held_pprev = mutex->held_next;
+    if (mutex->held_next) {
+        mutex->held_next->held_pprev = mutex->held_pprev;
+    }
+    mutex->held_next = NULL;
+    mutex->held_pprev = NULL;
+    mutex->owner = NULL;
+}
+
+/**
+ * @brief Raise a chain of owners to at least the given priority.
+ *
+ * Follows owner -> mutex it waits on -> that mutex's owner, so inheritance
+ * passes through nested locks.
+ */
+static void mutex_boost(task_t *owner, uint8_t priority)
+{
+    while (owner && priority < owner->priority) {
+        scheduler_set_priority(owner, priority);
+        owner = owner->waiting_mutex ? owner->waiting_mutex->owner : NULL;
+    }
+}
+
+/**
+ * @brief Priority a task is owed by the waiters of the mutexes it holds.
+ */
+static uint8_t mutex_owed_priority(const task_t *task)
+{
+    uint8_t priority = task->base_priority;
+
+    for (const mutex_t *mutex = task->held_mutexes; mutex; mutex = mutex->held_next) {
+        const task_t *waiter = wait_queue_peek(&mutex->waiters);
+
+        if (waiter && waiter->priority < priority) {
+            priority = waiter->priority;
+        }
+    }
+    return priority;
+}
+
+void mutex_init(mutex_t *mutex)
+{
+    mutex->owner = NULL;
+    mutex->held_next = NULL;
+    mutex->held_pprev = NULL;
+    wait_queue_init(&mutex->waiters);
+}
+
+int mutex_lock(mutex_t *mutex)
+{
+    uint32_t irq = irq_save();
+    task_t *task = current_task;
+    int ret = 0;
+
+    if (!task) {
+        // Single-threaded bring-up: nothing to exclude.
+    } else if (!scheduler_in_task() || mutex->owner == task) {
+        ret = -1;
+    } else if (!mutex->owner) {
+        mutex_take(mutex, task);
+    } else {
+        task->waiting_mutex = mutex;
+        wait_queue_insert(&mutex->waiters, task);
+        mutex_boost(mutex->owner, task->priority);
+        scheduler_block_current();
+        // mutex_unlock() made this task the owner before waking it.
+    }
+
+    irq_restore(irq);
+    return ret;
+}
+
+int mutex_trylock(mutex_t *mutex)
+{
+    uint32_t irq = irq_save();
+    task_t *task = current_task;
+    int ret = 0;
+
+    if (!task) {
+        // Single-threaded bring-up: nothing to exclude.
+    } else if (!scheduler_in_task() || mutex->owner) {
+        ret = -1;
+    } else {
+        mutex_take(mutex, task);
+    }
+
+    irq_restore(irq);
+    return ret;
+}
+
+int mutex_unlock(mutex_t *mutex)
+{
+    uint32_t irq = irq_save();
+    task_t *task = current_task;
+
+    if (!task) {
+        irq_restore(irq);
+        return 0;
+    }
+    if (mutex->owner != task) {
+        irq_restore(irq);
+        return -1;
+    }
+
+    mutex_drop(mutex);
+
+    task_t *next = wait_queue_pop(&mutex->waiters);
+    if (next) {
+        // Hand the mutex over so a more urgent task arriving before the
+        // waiter runs cannot take it first.
+        next->waiting_mutex = NULL;
+        mutex_take(mutex, next);
+        if (wait_queue_peek(&mutex->waiters)) {
+            mutex_boost(next, wait_queue_peek(&mutex->waiters)->priority);
+        }
+        scheduler_wake(next);
+    }
+
+    if (task->priority != task->base_priority) {
+        scheduler_set_priority(task, mutex_owed_priority(task));
+    }
+
+    irq_restore(irq);
+    return 0;
+}
@@ -18,7 +18,802 @@
 /**
  * @file scheduler.c
  * @brief Task scheduler implementation for KumoTrail kernel (ESP32-C3)
- * @version 
- * @date 
- * @author 
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Fixed-priority preemptive scheduler. Each priority level owns a FIFO ready
+ * queue and a bit in a 32-bit ready bitmap; the next task is found by a
+ * constant-time count-trailing-zeros on that bitmap, so selection costs the
+ * same no matter how many tasks exist. Tasks of equal priority share the CPU
+ * in round-robin order, one tick at a time.
+ */
+
+#include "scheduler.h"
+#include "kernel.h"
+#include "bitops.h"
+#include "csr.h"
+#include "irq.h"
+#include "context.h"
+#include "softtimer.h"
+#include "interrupt.h"
+#include "sysctl.h"
+#include "waitqueue.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#define TASK_STACK_WORDS (KERNEL_TASK_STACK_SIZE / sizeof(uint32_t))
+
+/** Software interrupt (FROM_CPU_INTRn) used to force a trap for a switch. */
+#define SCHEDULER_YIELD_INTR 0U
+
+/** Task that owns the CPU, NULL until scheduler_start(). */
+task_t *volatile current_task = NULL;
+
+/** Set when the trap exit path must call scheduler_switch(). */
+volatile uint32_t scheduler_switch_pending = 0;
+
+/** TCBs and stacks handed out by task_create(), part of the task table. */
+static task_t task_pool[KERNEL_MAX_TASKS] __attribute__((used, section(".kumotrail.tasks")));
+static uint32_t task_stacks[KERNEL_MAX_TASKS][TASK_STACK_WORDS]
+    __attribute__((aligned(16), section(".kumotrail.stacks")));
+
+/* Every TCB in the system, TASK_DEFINE() and pool alike (linker.ld). */
+extern task_t __kumotrail_tasks_start[];
+extern task_t __kumotrail_tasks_end[];
+
+/** Head and tail of the ready queue of each priority level. */
+static task_t *ready_head[KERNEL_MAX_PRIORITIES];
+static task_t *ready_tail[KERNEL_MAX_PRIORITIES];
+
+/** Bit n is set while ready_head[n] is non-empty. */
+static uint32_t ready_bitmap = 0;
+
+static volatile uint32_t scheduler_ticks = 0;
+
+/**
+ * Sleeping tasks in wake-up order. Each entry's sleep_delta is relative to
+ * the entry before it, so a tick only ever decrements the head.
+ */
+static task_t *sleep_head = NULL;
+
+/** Nesting depth of scheduler_lock(); preemption is held off while non-zero. */
+static volatile uint32_t scheduler_lock_depth = 0;
+
+/** Set when a switch was requested while the scheduler was locked. */
+static volatile uint32_t switch_deferred = 0;
+
+/** Set when the pending switch was asked for by the running task itself. */
+static uint32_t switch_voluntary = 0;
+
+/** mcycle and minstret when the current task was switched in. */
+static uint64_t switch_cycle_stamp = 0;
+static uint64_t switch_instret_stamp = 0;
+
+/* Boot stack bounds, painted by boot.S (linker.ld). Reused as the
+ * interrupt stack once the scheduler runs. */
+extern uint32_t __stack_bottom[];
+extern uint32_t __stack_top[];
+
+/* Restores the current task's frame and jumps into it (trap.S). */
+extern void _trap_launch_first_task(void) __attribute__((noreturn));
+
+/**
+ * @brief Append a task to the tail of its priority's ready queue.
+ */
+static void ready_queue_push(task_t *task)
+{
+    uint8_t prio = task->priority;
+
+    task->next = NULL;
+    task->prev = ready_tail[prio];
+    if (ready_tail[prio]) {
+        ready_tail[prio]->next = task;
+    } else {
+        ready_head[prio] = task;
+    }
+    ready_tail[prio] = task;
+    ready_bitmap |= (1U << prio);
+}
+
+/**
+ * @brief Unlink a task from its priority's ready queue.
+ */
+static void ready_queue_remove(task_t *task)
+{
+    uint8_t prio = task->priority;
+
+    if (task->prev) {
+        task->prev->next = task->next;
+    } else {
+        ready_head[prio] = task->next;
+    }
+    if (task->next) {
+        task->next->prev = task->prev;
+    } else {
+        ready_tail[prio] = task->prev;
+    }
+    task->next = NULL;
+    task->prev = NULL;
+
+    if (!ready_head[prio]) {
+        ready_bitmap &= ~(1U << prio);
+    }
+}
+
+/**
+ * @brief Return the head of the most urgent non-empty ready queue.
+ *
+ * The idle task is always ready, so the bitmap is never empty once
+ * scheduler_init() has run.
+ */
+static task_t *ready_queue_highest(void)
+{
+    return ready_head[bitops_ctz32(ready_bitmap)];
+}
+
+/**
+ * @brief Landing address for task functions that return.
+ *
+ * The task is retired and the CPU is handed to the next ready task as soon
+ * as interrupts are enabled again. Its TCB only becomes free for
+ * task_create() once scheduler_switch() has left it, since until then the
+ * task is still running on its stack.
+ */
+static void task_exit(void)
+{
+    irq_disable();
+
+    task_t *task = current_task;
+    ready_queue_remove(task);
+    task->state = TASK_EXITED;
+    scheduler_request_switch();
+
+    irq_enable();
+    while (1)
+    {
+    }
+}
+
+/**
+ * @brief Ticks to sleep so that at least 'ms' milliseconds pass.
+ *
+ * The first tick boundary may be only moments away, so it does not count
+ * towards the delay.
+ */
+static uint32_t sleep_ticks_from_ms(uint32_t ms)
+{
+    return KERNEL_MS_TO_TICKS(ms) + 1U;
+}
+
+/**
+ * @brief Insert a task into the sleep list to expire after 'ticks' ticks.
+ */
+static void sleep_insert(task_t *task, uint32_t ticks)
+{
+    task_t **link = &sleep_head;
+
+    while (*link && (*link)->sleep_delta <= ticks) {
+        ticks -= (*link)->sleep_delta;
+        link = &(*link)->sleep_next;
+    }
+
+    task->sleep_delta = ticks;
+    task->sleep_next = *link;
+    task->sleep_pprev = link;
+    if (task->sleep_next) {
+        task->sleep_next->sleep_delta -= ticks;
+        task->sleep_next->sleep_pprev = &task->sleep_next;
+    }
+    *link = task;
+}
+
+/**
+ * @brief Take a task off the sleep list, handing its delta to its successor.
+ */
+static void sleep_remove(task_t *task)
+{
+    *task->sleep_pprev = task->sleep_next;
+    if (task->sleep_next) {
+        task->sleep_next->sleep_delta += task->sleep_delta;
+        task->sleep_next->sleep_pprev = task->sleep_pprev;
+    }
+    task->sleep_next = NULL;
+    task->sleep_pprev = NULL;
+}
+
+/**
+ * @brief Let 'ticks' ticks pass on the sleep list and wake whoever expires.
+ */
+static void sleep_advance(uint32_t ticks)
+{
+    while (sleep_head) {
+        task_t *task = sleep_head;
+
+        if (task->sleep_delta > ticks) {
+            task->sleep_delta -= ticks;
+            return;
+        }
+        ticks -= task->sleep_delta;
+        task->sleep_delta = 0;
+        // A timed wait on an object ends here with wait_status still -1.
+        wait_queue_remove(task);
+        scheduler_wake(task);
+    }
+}
+
+/**
+ * @brief Block the current task for 'ticks' ticks. Interrupts must be
+ * disabled.
+ */
+static void sleep_current(uint32_t ticks)
+{
+    if (!current_task || !ticks) {
+        return;
+    }
+    sleep_insert(current_task, ticks);
+    scheduler_block_current();
+}
+
+/**
+ * @brief Handler of the yield software interrupt.
+ *
+ * The switch itself is requested before the interrupt is raised; taking
+ * the trap is all that is needed, as its exit path performs the switch.
+ */
+static void scheduler_yield_handler(void *arg)
+{
+    (void)arg;
+    sysctl_cpu_intr_clear(SCHEDULER_YIELD_INTR);
+}
+
+/**
+ * @brief Build the frame a task is first entered with.
+ *
+ * The frame looks exactly like one saved by _trap_handler, so the first
+ * switch to a task is an ordinary trap return into func with interrupts
+ * enabled.
+ */
+static volatile uint32_t *task_init_frame(uint32_t *stack_top, task_func_t func)
+{
+    trap_frame_t *frame = (trap_frame_t *)stack_top - 1;
+    uint32_t *words = (uint32_t *)frame;
+    uint32_t gp;
+
+    for (uint32_t i = 0; i < sizeof(trap_frame_t) / sizeof(uint32_t); i++) {
+        words[i] = 0;
+    }
+    asm volatile ("mv %0, gp" : "=r"(gp));
+
+    frame->mepc = (uint32_t)func;
+    frame->mstatus = MSTATUS_MPP_M | MSTATUS_MPIE;
+    frame->ra = (uint32_t)task_exit;
+    frame->gp = gp;
+
+    return (volatile uint32_t *)frame;
+}
+
+/**
+ * @brief Fill a stack with KERNEL_STACK_PAINT.
+ */
+static void stack_paint(uint32_t *base, uint32_t words)
+{
+    for (uint32_t i = 0; i < words; i++) {
+        base[i] = KERNEL_STACK_PAINT;
+    }
+}
+
+/**
+ * @brief Bytes of a painted stack that have been written at least once.
+ */
+static uint32_t stack_high_water(const uint32_t *base, uint32_t words)
+{
+    uint32_t untouched = 0;
+
+    while (untouched < words && base[untouched] == KERNEL_STACK_PAINT) {
+        untouched++;
+    }
+    return (words - untouched) * sizeof(uint32_t);
+}
+
+/**
+ * @brief Paint a task's stack, build its first frame and make it READY.
+ *
+ * stack_base, stack_size, entry and priority must already be set.
  */
+static void task_prepare(task_t *task)
+{
+    uint32_t words = task->stack_size / sizeof(uint32_t);
+
+    stack_paint(task->stack_base, words);
+    task->stack_pointer = task_init_frame(&task->stack_base[words], task->entry);
+    task->state = TASK_READY;
+    task->base_priority = task->priority;
+    task->sleep_next = NULL;
+    task->sleep_pprev = NULL;
+    task->sleep_delta = 0;
+    task->wait_queue = NULL;
+    task->wait_next = NULL;
+    task->wait_pprev = NULL;
+    task->wait_status = 0;
+    task->wait_value = 0;
+    task->wait_options = 0;
+    task->wait_data = NULL;
+    task->waiting_mutex = NULL;
+    task->held_mutexes = NULL;
+    task->notify_value = 0;
+    task->notify_state = TASK_NOTIFY_IDLE;
+    task->cycles = 0;
+    task->instret = 0;
+    task->voluntary_switches = 0;
+    task->involuntary_switches = 0;
+    task->last_run_tick = 0;
+}
+
+static task_t *task_alloc(task_func_t func, uint8_t priority)
+{
+    for (int i = 0; i < KERNEL_MAX_TASKS; i++) {
+        task_t *task = &task_pool[i];
+        if (task->state == TASK_UNUSED) {
+            task->stack_base = task_stacks[i];
+            task->stack_size = KERNEL_TASK_STACK_SIZE;
+            task->priority = priority;
+            task->entry = func;
+            task_prepare(task);
+            return task;
+        }
+    }
+    return NULL;
+}
+
+void scheduler_init(void)
+{
+    for (int i = 0; i < KERNEL_MAX_PRIORITIES; i++) {
+        ready_head[i] = NULL;
+        ready_tail[i] = NULL;
+    }
+    ready_bitmap = 0;
+    sleep_head = NULL;
+    scheduler_lock_depth = 0;
+    switch_deferred = 0;
+    current_task = NULL;
+    scheduler_switch_pending = 0;
+    scheduler_ticks = 0;
+
+    for (int i = 0; i < KERNEL_MAX_TASKS; i++) {
+        task_pool[i].state = TASK_UNUSED;
+    }
+
+    interrupt_set_type(INTERRUPT_LINE_YIELD, INTERRUPT_TYPE_LEVEL);
+    interrupt_set_priority(INTERRUPT_LINE_YIELD, INTERRUPT_PRIORITY_YIELD);
+    interrupt_attach(INTERRUPT_SOURCE_FROM_CPU_INTR0, scheduler_yield_handler, NULL);
+
+    // Pool entries have no entry function until task_create() fills them.
+    for (task_t *task = __kumotrail_tasks_start; task < __kumotrail_tasks_end; task++) {
+        if (task->entry && (task < task_pool || task >= &task_pool[KERNEL_MAX_TASKS])) {
+            task_prepare(task);
+            ready_queue_push(task);
+        }
+    }
+}
+
+int task_create(task_func_t func)
+{
+    return task_create_with_priority(func, KERNEL_DEFAULT_PRIORITY);
+}
+
+int task_create_with_priority(task_func_t func, uint8_t priority)
+{
+    if (!func || priority >= KERNEL_IDLE_PRIORITY) {
+        return -1;
+    }
+
+    uint32_t irq = irq_save();
+
+    task_t *task = task_alloc(func, priority);
+    if (task) {
+        ready_queue_push(task);
+        if (current_task && priority < current_task->priority) {
+            scheduler_request_switch();
+        }
+    }
+
+    irq_restore(irq);
+    return task ? 0 : -1;
+}
+
+task_t *task_current(void)
+{
+    return current_task;
+}
+
+uint32_t scheduler_get_ticks(void)
+{
+    return scheduler_ticks;
+}
+
+uint32_t scheduler_idle_ticks(void)
+{
+    if (scheduler_switch_pending || (ready_bitmap & ~(1U << KERNEL_IDLE_PRIORITY))) {
+        return 0;
+    }
+
+    uint32_t ticks = softtimer_ticks_to_next();
+    if (sleep_head && sleep_head->sleep_delta < ticks) {
+        ticks = sleep_head->sleep_delta;
+    }
+    if (ticks > KERNEL_TICKLESS_MAX_IDLE_TICKS) {
+        ticks = KERNEL_TICKLESS_MAX_IDLE_TICKS;
+    }
+    return ticks;
+}
+
+void scheduler_step_ticks(uint32_t ticks)
+{
+    scheduler_ticks += ticks;
+    sleep_advance(ticks);
+    softtimer_advance(ticks);
+}
+
+void scheduler_tick(void)
+{
+    // The tick handler runs with MIE set so more urgent lines can nest;
+    // keep the wheel and the ready queues consistent against them.
+    uint32_t irq = irq_save();
+    task_t *task = current_task;
+
+    scheduler_ticks++;
+    sleep_advance(1);
+    softtimer_tick();
+    if (task) {
+        /* Time slice: rotate the running task behind its equal-priority peers. */
+        if (task->state == TASK_RUNNING && task->next) {
+            ready_queue_remove(task);
+            ready_queue_push(task);
+        }
+
+        if (ready_queue_highest() != task) {
+            scheduler_request_switch();
+        }
+    }
+
+    irq_restore(irq);
+}
+
+int scheduler_in_task(void)
+{
+    // mscratch holds the interrupt stack top only while a task runs.
+    return current_task && read_csr(mscratch) != 0;
+}
+
+void scheduler_request_switch(void)
+{
+    // A locked task keeps the CPU unless it is giving it up itself.
+    if (scheduler_lock_depth && current_task && current_task->state == TASK_RUNNING) {
+        switch_deferred = 1;
+        return;
+    }
+
+    scheduler_switch_pending = 1;
+
+    // Inside a trap the exit path already checks the flag. A task has to
+    // be interrupted for the switch to happen right away.
+    if (scheduler_in_task()) {
+        sysctl_cpu_intr_set(SCHEDULER_YIELD_INTR);
+    }
+}
+
+void scheduler_lock(void)
+{
+    // Only tasks change the depth, and a preempting task always restores
+    // it, so the increment needs no masking.
+    scheduler_lock_depth++;
+}
+
+void scheduler_unlock(void)
+{
+    uint32_t irq = irq_save();
+
+    if (scheduler_lock_depth && --scheduler_lock_depth == 0 && switch_deferred) {
+        switch_deferred = 0;
+        scheduler_request_switch();
+    }
+
+    irq_restore(irq);
+}
+
+void task_yield(void)
+{
+    uint32_t irq = irq_save();
+    task_t *task = current_task;
+
+    // Only a peer of equal priority can gain from this; anything more
+    // urgent would already have preempted the caller.
+    if (task && task->next) {
+        ready_queue_remove(task);
+        ready_queue_push(task);
+        switch_voluntary = 1;
+        scheduler_request_switch();
+    }
+
+    irq_restore(irq);
+}
+
+void task_sleep_ms(uint32_t ms)
+{
+    uint32_t irq = irq_save();
+    if (ms) {
+        sleep_current(sleep_ticks_from_ms(ms));
+    }
+    irq_restore(irq);
+}
+
+int task_delay_until(uint32_t *wake_tick, uint32_t period_ticks)
+{
+    uint32_t irq = irq_save();
+    uint32_t target = *wake_tick + period_ticks;
+    int32_t remaining = (int32_t)(target - scheduler_ticks);
+
+    // Advance by the period, not from now, so lateness never accumulates.
+    *wake_tick = target;
+    if (remaining > 0) {
+        sleep_current((uint32_t)remaining);
+    }
+
+    irq_restore(irq);
+    return remaining > 0 ? 0 : -1;
+}
+
+int task_notify(task_t *task, uint32_t value, task_notify_action_e action)
+{
+    if (!task) {
+        return -1;
+    }
+
+    uint32_t irq = irq_save();
+
+    if (task->state == TASK_UNUSED) {
+        irq_restore(irq);
+        return -1;
+    }
+
+    switch (action) {
+    case TASK_NOTIFY_SET_BITS:
+        task->notify_value |= value;
+        break;
+    case TASK_NOTIFY_INCREMENT:
+        task->notify_value++;
+        break;
+    case TASK_NOTIFY_OVERWRITE:
+        task->notify_value = value;
+        break;
+    }
+
+    if (task->notify_state == TASK_NOTIFY_WAITING) {
+        scheduler_wake(task);
+    }
+    task->notify_state = TASK_NOTIFY_PENDING;
+
+    irq_restore(irq);
+    return 0;
+}
+
+int task_notify_wait(uint32_t clear_bits, uint32_t *value, uint32_t timeout_ms)
+{
+    uint32_t irq = irq_save();
+    task_t *task = current_task;
+    int ret = -1;
+
+    if (!scheduler_in_task()) {
+        irq_restore(irq);
+        return -1;
+    }
+
+    if (task->notify_state != TASK_NOTIFY_PENDING && timeout_ms != KERNEL_NO_WAIT) {
+        task->notify_state = TASK_NOTIFY_WAITING;
+        if (timeout_ms != KERNEL_WAIT_FOREVER) {
+            sleep_insert(task, sleep_ticks_from_ms(timeout_ms));
+        }
+        scheduler_block_current();
+    }
+
+    // PENDING here means task_notify() ran, whether before or during the wait.
+    if (task->notify_state == TASK_NOTIFY_PENDING) {
+        if (value) {
+            *value = task->notify_value;
+        }
+        task->notify_value &= ~clear_bits;
+        ret = 0;
+    }
+    task->notify_state = TASK_NOTIFY_IDLE;
+
+    irq_restore(irq);
+    return ret;
+}
+
+int scheduler_wait(wait_queue_t *queue, uint32_t timeout_ms)
+{
+    task_t *task = current_task;
+
+    if (!scheduler_in_task() || timeout_ms == KERNEL_NO_WAIT) {
+        return -1;
+    }
+
+    task->wait_status = -1;
+    wait_queue_insert(queue, task);
+    if (timeout_ms != KERNEL_WAIT_FOREVER) {
+        sleep_insert(task, sleep_ticks_from_ms(timeout_ms));
+    }
+    scheduler_block_current();
+
+    return task->wait_status;
+}
+
+void scheduler_wake_waiter(task_t *task)
+{
+    wait_queue_remove(task);
+    task->wait_status = 0;
+    scheduler_wake(task);
+}
+
+void scheduler_block_current(void)
+{
+    task_t *task = current_task;
+
+    scheduler_block(task);
+    irq_enable();
+    // The yield interrupt lands within a few cycles; once it returns here
+    // the task has been woken.
+    while (task->state == TASK_BLOCKED)
+    {
+    }
+    irq_disable();
+}
+
+void scheduler_block(task_t *task)
+{
+    ready_queue_remove(task);
+    task->state = TASK_BLOCKED;
+    if (task == current_task) {
+        scheduler_request_switch();
+    }
+}
+
+void scheduler_wake(task_t *task)
+{
+    if (task->state != TASK_BLOCKED) {
+        return;
+    }
+    if (task->sleep_pprev) {
+        sleep_remove(task);
+    }
+    task->state = TASK_READY;
+    ready_queue_push(task);
+    if (current_task && task->priority < current_task->priority) {
+        scheduler_request_switch();
+    }
+}
+
+void scheduler_set_priority(task_t *task, uint8_t priority)
+{
+    if (task->priority == priority) {
+        return;
+    }
+
+    if (task->state == TASK_READY || task->state == TASK_RUNNING) {
+        ready_queue_remove(task);
+        task->priority = priority;
+        ready_queue_push(task);
+    } else if (task->wait_queue) {
+        wait_queue_t *queue = task->wait_queue;
+
+        wait_queue_remove(task);
+        task->priority = priority;
+        wait_queue_insert(queue, task);
+    } else {
+        task->priority = priority;
+    }
+
+    if (current_task && ready_queue_highest()->priority < current_task->priority) {
+        scheduler_request_switch();
+    }
+}
+
+void scheduler_switch(void)
+{
+    task_t *prev = current_task;
+    task_t *next = ready_queue_highest();
+
+    uint32_t voluntary = switch_voluntary;
+
+    scheduler_switch_pending = 0;
+    switch_voluntary = 0;
+    if (next == prev) {
+        // Woken again before the switch away happened.
+        next->state = TASK_RUNNING;
+        return;
+    }
+
+    uint64_t cycle = read_csr64(mcycle);
+    uint64_t instret = read_csr64(minstret);
+
+    if (prev) {
+        prev->cycles += cycle - switch_cycle_stamp;
+        prev->instret += instret - switch_instret_stamp;
+        if (prev->state == TASK_RUNNING) {
+            prev->state = TASK_READY;
+        } else {
+            voluntary = 1;
+        }
+        if (prev->state == TASK_EXITED) {
+            // Its context is saved and will never be restored: free the TCB.
+            prev->state = TASK_UNUSED;
+        }
+        if (voluntary) {
+            prev->voluntary_switches++;
+        } else {
+            prev->involuntary_switches++;
+        }
+    }
+    switch_cycle_stamp = cycle;
+    switch_instret_stamp = instret;
+
+    next->state = TASK_RUNNING;
+    next->last_run_tick = scheduler_ticks;
+    current_task = next;
+}
+
+uint32_t task_stack_high_water(const task_t *task)
+{
+    return stack_high_water(task->stack_base, task->stack_size / sizeof(uint32_t));
+}
+
+uint32_t kernel_stack_high_water(void)
+{
+    return stack_high_water(__stack_bottom, (uint32_t)(__stack_top - __stack_bottom));
+}
+
+uint32_t task_stats_snapshot(task_stats_t *out, uint32_t max)
+{
+    uint32_t count = 0;
+    uint32_t irq = irq_save();
+    uint64_t cycle = read_csr64(mcycle);
+    uint64_t instret = read_csr64(minstret);
+
+    for (const task_t *task = __kumotrail_tasks_start;
+         task < __kumotrail_tasks_end && count < max; task++) {
+        task_stats_t *stats = &out[count];
+
+        if (task->state == TASK_UNUSED) {
+            continue;
+        }
+        stats->entry = task->entry;
+        stats->priority = task->priority;
+        stats->state = task->state;
+        stats->cycles = task->cycles;
+        stats->instret = task->instret;
+        stats->voluntary_switches = task->voluntary_switches;
+        stats->involuntary_switches = task->involuntary_switches;
+        stats->last_run_tick = task->last_run_tick;
+        if (task == current_task) {
+            stats->cycles += cycle - switch_cycle_stamp;
+            stats->instret += instret - switch_instret_stamp;
+        }
+        count++;
+    }
+
+    irq_restore(irq);
+    return count;
+}
+
+void scheduler_start(void)
+{
+    irq_disable();
+
+    // main() never gets control back, so its stack becomes the interrupt
+    // stack; the trap entry picks it up from mscratch.
+    write_csr(mscratch, (uint32_t)__stack_top);
+
+    scheduler_switch();
+    _trap_launch_first_task();
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file semaphore.c
+ * @brief Counting semaphores with direct handoff to waiters.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ */
+
+#include "semaphore.h"
+#include "scheduler.h"
+#include "waitqueue.h"
+#include "irq.h"
+#include <stdint.h>
+#include <stddef.h>
+
+void semaphore_init(semaphore_t *sem, uint32_t initial, uint32_t max_count)
+{
+    sem->count = initial;
+    sem->max_count = max_count;
+    wait_queue_init(&sem->waiters);
+}
+
+int semaphore_take(semaphore_t *sem, uint32_t timeout_ms)
+{
+    uint32_t irq = irq_save();
+    int ret = 0;
+
+    if (sem->count) {
+        sem->count--;
+    } else {
+        // On success semaphore_give() handed the token over directly.
+        ret = scheduler_wait(&sem->waiters, timeout_ms);
+    }
+
+    irq_restore(irq);
+    return ret;
+}
+
+int semaphore_give(semaphore_t *sem)
+{
+    uint32_t irq = irq_save();
+    task_t *waiter = wait_queue_peek(&sem->waiters);
+    int ret = 0;
+
+    if (waiter) {
+        scheduler_wake_waiter(waiter);
+    } else if (sem->count < sem->max_count) {
+        sem->count++;
+    } else {
+        ret = -1;
+    }
+
+    irq_restore(irq);
+    return ret;
+}
+
+uint32_t semaphore_count(const semaphore_t *sem)
+{
+    return sem->count;
+}
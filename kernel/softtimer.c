@@ -0,0 +1,261 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file softtimer.c
+ * @brief Hierarchical timing wheel for kernel software timers.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Level 0 has one slot per tick for the next 32 ticks, level 1 one slot per
+ * 32 ticks for the next 1024, and so on. A timer is hashed into the lowest
+ * level whose range covers its remaining delay. Whenever the level-0 index
+ * wraps to zero, the current slot of the next level is cascaded: its timers
+ * are re-hashed into lower levels, which is the only time a timer moves.
+ *
+ * Slots are singly linked lists with a back-pointer to the referencing
+ * link, so a timer can be removed in O(1) without knowing its slot head.
+ * A per-level occupancy bitmap lets the tickless idle path find the next
+ * deadline without scanning slots.
+ */
+
+#include "softtimer.h"
+#include "bitops.h"
+#include "irq.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#define WHEEL_SLOT_BITS     5U
+#define WHEEL_SLOTS         (1U << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK     (WHEEL_SLOTS - 1U)
+
+/** Marks a timer that is linked on the local expiry list, not in a slot. */
+#define WHEEL_LEVEL_EXPIRED SOFTTIMER_LEVELS
+
+static softtimer_t *wheel[SOFTTIMER_LEVELS][WHEEL_SLOTS];
+
+/** Bit n of wheel_occupied[l] is set while wheel[l][n] is non-empty. */
+static uint32_t wheel_occupied[SOFTTIMER_LEVELS];
+
+/** Next tick the wheel will process. */
+static uint32_t wheel_time = 0;
+
+static void wheel_link(softtimer_t **head, softtimer_t *timer)
+{
+    timer->next = *head;
+    if (timer->next) {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = head;
+    *head = timer;
+}
+
+static void wheel_unlink(softtimer_t *timer)
+{
+    *timer->pprev = timer->next;
+    if (timer->next) {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->next = NULL;
+    timer->pprev = NULL;
+
+    if (timer->level != WHEEL_LEVEL_EXPIRED &&
+        !wheel[timer->level][timer->slot]) {
+        wheel_occupied[timer->level] &= ~(1U << timer->slot);
+    }
+}
+
+/**
+ * @brief Hash a timer into the lowest level that covers its remaining delay.
+ */
+static void wheel_insert(softtimer_t *timer)
+{
+    uint32_t delta = timer->expires - wheel_time;
+    uint32_t level = 0;
+
+    if ((int32_t)delta < 0) {
+        // Already due: fire on the next processed tick.
+        timer->expires = wheel_time;
+        delta = 0;
+    }
+    while (level < SOFTTIMER_LEVELS - 1U &&
+           delta >= (1U << (WHEEL_SLOT_BITS * (level + 1U)))) {
+        level++;
+    }
+
+    uint32_t slot = (timer->expires >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK;
+
+    timer->level = (uint8_t)level;
+    timer->slot = (uint8_t)slot;
+    wheel_link(&wheel[level][slot], timer);
+    wheel_occupied[level] |= (1U << slot);
+}
+
+/**
+ * @brief Re-hash every timer of one slot into the levels below it.
+ */
+static void wheel_cascade(uint32_t level, uint32_t slot)
+{
+    softtimer_t *timer = wheel[level][slot];
+
+    wheel[level][slot] = NULL;
+    wheel_occupied[level] &= ~(1U << slot);
+
+    while (timer) {
+        softtimer_t *next = timer->next;
+        wheel_insert(timer);
+        timer = next;
+    }
+}
+
+void softtimer_init(softtimer_t *timer, softtimer_func_t callback, void *arg)
+{
+    timer->next = NULL;
+    timer->pprev = NULL;
+    timer->expires = 0;
+    timer->period = 0;
+    timer->callback = callback;
+    timer->arg = arg;
+    timer->level = 0;
+    timer->slot = 0;
+}
+
+void softtimer_start(softtimer_t *timer, uint32_t delay_ticks, uint32_t period_ticks)
+{
+    if (delay_ticks == 0) {
+        delay_ticks = 1;
+    }
+    if (delay_ticks > SOFTTIMER_MAX_TICKS) {
+        delay_ticks = SOFTTIMER_MAX_TICKS;
+    }
+    if (period_ticks > SOFTTIMER_MAX_TICKS) {
+        period_ticks = SOFTTIMER_MAX_TICKS;
+    }
+
+    uint32_t irq = irq_save();
+
+    if (timer->pprev) {
+        wheel_unlink(timer);
+    }
+    timer->expires = wheel_time + delay_ticks - 1U;
+    timer->period = period_ticks;
+    wheel_insert(timer);
+
+    irq_restore(irq);
+}
+
+void softtimer_stop(softtimer_t *timer)
+{
+    uint32_t irq = irq_save();
+
+    if (timer->pprev) {
+        wheel_unlink(timer);
+    }
+
+    irq_restore(irq);
+}
+
+int softtimer_is_active(const softtimer_t *timer)
+{
+    return timer->pprev != NULL;
+}
+
+void softtimer_tick(void)
+{
+    uint32_t index = wheel_time & WHEEL_SLOT_MASK;
+
+    if (index == 0) {
+        for (uint32_t level = 1; level < SOFTTIMER_LEVELS; level++) {
+            uint32_t slot = (wheel_time >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK;
+            wheel_cascade(level, slot);
+            if (slot != 0) {
+                break;
+            }
+        }
+    }
+
+    // Move the due slot to a local list so callbacks that re-arm a timer
+    // into the same slot cannot make this loop run forever.
+    softtimer_t *expired = wheel[0][index];
+    wheel[0][index] = NULL;
+    wheel_occupied[0] &= ~(1U << index);
+    if (expired) {
+        expired->pprev = &expired;
+    }
+    for (softtimer_t *timer = expired; timer; timer = timer->next) {
+        timer->level = WHEEL_LEVEL_EXPIRED;
+    }
+
+    wheel_time++;
+
+    while (expired) {
+        softtimer_t *timer = expired;
+
+        wheel_unlink(timer);
+        if (timer->period) {
+            timer->expires += timer->period;
+            wheel_insert(timer);
+        }
+        timer->callback(timer->arg);
+    }
+}
+
+void softtimer_advance(uint32_t ticks)
+{
+    // The wheel has nothing to process or cascade on the ticks before the
+    // next deadline, so they can be skipped by moving the time alone.
+    uint32_t quiet = softtimer_ticks_to_next() - 1U;
+
+    if (quiet > ticks) {
+        quiet = ticks;
+    }
+    wheel_time += quiet;
+    ticks -= quiet;
+
+    while (ticks--) {
+        softtimer_tick();
+    }
+}
+
+uint32_t softtimer_ticks_to_next(void)
+{
+    uint32_t best = SOFTTIMER_MAX_TICKS;
+
+    for (uint32_t level = 0; level < SOFTTIMER_LEVELS; level++) {
+        uint32_t occupied = wheel_occupied[level];
+        if (!occupied) {
+            continue;
+        }
+
+        // A slot of this level is processed (level 0) or cascaded (above)
+        // on a tick that is a multiple of 'unit', once per lap of 32 units.
+        uint32_t shift = WHEEL_SLOT_BITS * level;
+        uint32_t unit = 1U << shift;
+        uint32_t first = (wheel_time + unit - 1U) & ~(unit - 1U);
+        uint32_t index = (first >> shift) & WHEEL_SLOT_MASK;
+        uint32_t rotated = index ? (occupied >> index) | (occupied << (WHEEL_SLOTS - index))
+                                 : occupied;
+        uint32_t due = first + bitops_ctz32(rotated) * unit;
+        uint32_t ticks = due - wheel_time + 1U;
+
+        if (ticks < best) {
+            best = ticks;
+        }
+    }
+
+    return best;
+}
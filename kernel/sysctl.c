@@ -38,6 +38,13 @@
 #define SYSTEM_PERIP_CLK_EN0_REG (*(volatile uint32_t*)(SYSREG_BASE_ADDR + 0x0010))
 #define SYSTEM_PERIP_RST_EN0_REG (*(volatile uint32_t*)(SYSREG_BASE_ADDR + 0x0018))
 
+/*
+ * Software Interrupt Registers (FROM_CPU_INTR0-3)
+ */
+#define SYSTEM_CPU_INTR_FROM_CPU_REG(n) (*(volatile uint32_t*)(SYSREG_BASE_ADDR + 0x0028 + ((n) * 4)))
+#define SYSTEM_CPU_INTR_FROM_CPU      (1U << 0)
+#define SYSTEM_CPU_INTR_COUNT         4U
+
 /*
  * Bitmasks for SYSTEM_PERIP_CLK_EN0_REG and SYSTEM_PERIP_RST_EN0_REG
  */
@@ -112,3 +119,27 @@ void sysctl_reset_peripheral(peripheral_t peripheral)
         SYSTEM_PERIP_RST_EN0_REG &= ~reset_bit;
     }
 }
+
+/**
+ * @brief Raises a software interrupt.
+ */
+void sysctl_cpu_intr_set(uint32_t n)
+{
+    if (n < SYSTEM_CPU_INTR_COUNT)
+    {
+        SYSTEM_CPU_INTR_FROM_CPU_REG(n) = SYSTEM_CPU_INTR_FROM_CPU;
+        // Make sure the write has reached the matrix before returning.
+        asm volatile ("fence" : : : "memory");
+    }
+}
+
+/**
+ * @brief Lowers a software interrupt.
+ */
+void sysctl_cpu_intr_clear(uint32_t n)
+{
+    if (n < SYSTEM_CPU_INTR_COUNT)
+    {
+        SYSTEM_CPU_INTR_FROM_CPU_REG(n) = 0;
+    }
+}
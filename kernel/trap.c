@@ -23,58 +23,45 @@
  */
 
 #include "trap.h"
-#include "timer.h"
 #include "uart.h"
+#include "csr.h"
+#include "irq.h"
+#include "interrupt.h"
 #include <stdint.h>
 
-/* RISC-V CSR register definitions */
-#define CSR_MSTATUS 0x300
-#define CSR_MTVEC 0x305
-#define CSR_MCAUSE 0x342
-#define MSTATUS_MIE_BIT (1U << 3)
+/* mtvec MODE field: interrupts jump to BASE + 4 * cause */
+#define MTVEC_MODE_VECTORED 1U
 
-/* Assembly trap handler forward declaration */
-extern void _trap_handler(void);
-
-/* CSR write macro - requires compile-time constant CSR address */
-#define write_csr(csr, value) \
-({ \
-    uint32_t __v = (uint32_t)(value); \
-    asm volatile ("csrw " #csr ", %0" \
-                  : : "r"(__v) \
-                  : "memory"); \
-})
-
-/* CSR read macro - requires compile-time constant CSR address */
-#define read_csr(csr) \
-({ \
-    uint32_t __v; \
-    asm volatile ("csrr %0, " #csr \
-                  : "=r"(__v) : : "memory"); \
-    __v; \
-})
+/* Vector table forward declaration (arch/riscv/vectors.S) */
+extern void _vector_table(void);
 
 /**
- * Initialize the trap system by setting machine trap vector
+ * Initialize the trap system by pointing mtvec at the vector table
+ * in vectored mode. Exceptions still enter through _trap_handler.
+ * mscratch stays 0 until scheduler_start() hands over the interrupt
+ * stack, so traps taken during boot stay on the boot stack.
  */
 void trap_init(void)
 {
-    asm volatile ("csrw mtvec, %0" : : "r"((uint32_t)_trap_handler));
+    write_csr(mscratch, 0);
+    write_csr(mtvec, (uint32_t)_vector_table | MTVEC_MODE_VECTORED);
+    interrupt_set_threshold(INTERRUPT_PRIORITY_MIN);
 }
 
 /**
- * Enable machine-level interrupts by setting MIE bit in mstatus
+ * Enable machine-level interrupts by setting MIE bit in mstatus, with a
+ * single csrrs so a trap cannot slip between reading and writing it
  */
 void enable_interrupts(void)
 {
-    uint32_t mstatus = read_csr(mstatus);
-    mstatus |= MSTATUS_MIE_BIT;
-    write_csr(mstatus, mstatus);
+    irq_enable();
 }
 
 /**
  * Main C-level trap handler called from assembly
- * Determines trap cause and dispatches to appropriate handler
+ * Determines trap cause and dispatches to appropriate handler. In vectored
+ * mode only exceptions arrive here; the interrupt branch covers the direct
+ * mode fallback.
  */
 void trap_handler_c(void)
 {
@@ -82,16 +69,7 @@ void trap_handler_c(void)
     
     if (cause & 0x80000000)
     {
-        uint32_t interrupt_id = cause & 0x7FFFFFFF;
-        switch (interrupt_id)
-        {
-            case 6:
-                timer_handle_interrupt();
-                break;
-            default:
-                uart_puts("Unknown interrupt occurred\n");
-                break;
-        }
+        interrupt_dispatch(cause & 0x7FFFFFFF);
     }
     else
     {
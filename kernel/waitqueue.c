@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file waitqueue.c
+ * @brief Priority-ordered wait queues.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * A queue is a singly linked list sorted by priority, with a back-pointer
+ * to the referencing link in every waiter. Insertion walks past the waiters
+ * that are at least as urgent, which is short in practice; removal from
+ * anywhere in the queue, as needed for priority changes, is O(1).
+ */
+
+#include "waitqueue.h"
+#include <stdint.h>
+#include <stddef.h>
+
+void wait_queue_init(wait_queue_t *queue)
+{
+    queue->head = NULL;
+}
+
+void wait_queue_insert(wait_queue_t *queue, task_t *task)
+{
+    task_t **link = &queue->head;
+
+    while (*link && (*link)->priority <= task->priority) {
+        link = &(*link)->wait_next;
+    }
+
+    task->wait_next = *link;
+    if (task->wait_next) {
+        task->wait_next->wait_pprev = &task->wait_next;
+    }
+    task->wait_pprev = link;
+    task->wait_queue = queue;
+    *link = task;
+}
+
+void wait_queue_remove(task_t *task)
+{
+    if (!task->wait_pprev) {
+        return;
+    }
+
+    *task->wait_pprev = task->wait_next;
+    if (task->wait_next) {
+        task->wait_next->wait_pprev = task->wait_pprev;
+    }
+    task->wait_next = NULL;
+    task->wait_pprev = NULL;
+    task->wait_queue = NULL;
+}
+
+task_t *wait_queue_pop(wait_queue_t *queue)
+{
+    task_t *task = queue->head;
+
+    if (task) {
+        wait_queue_remove(task);
+    }
+    return task;
+}
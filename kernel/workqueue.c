@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 fokaz-c
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file workqueue.c
+ * @brief Deferred-work ring and its kernel worker task.
+ * @version 1.0
+ * @date 16-10-2026
+ * @author fokaz-c
+ *
+ * Producers only ever write work_head and the worker only ever writes
+ * work_tail, so the worker drains the ring without masking interrupts.
+ * Because interrupts nest, several handlers can be producers at once; they
+ * are serialised by masking MIE for the few instructions that claim a slot.
+ */
+
+#include "workqueue.h"
+#include "scheduler.h"
+#include "kernel.h"
+#include "irq.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#define WORK_MASK (KERNEL_WORKQUEUE_DEPTH - 1U)
+
+typedef struct {
+    work_func_t fn;
+    void *arg;
+} work_item_t;
+
+static work_item_t work_ring[KERNEL_WORKQUEUE_DEPTH];
+
+/** Next slot to fill (producers) and next slot to run (worker). */
+static volatile uint32_t work_head = 0;
+static volatile uint32_t work_tail = 0;
+
+static void workqueue_worker(void);
+
+TASK_DEFINE(work_tcb, workqueue_worker, KERNEL_WORKQUEUE_PRIORITY, KERNEL_WORKQUEUE_STACK_SIZE);
+
+static void workqueue_worker(void)
+{
+    while (1)
+    {
+        while (work_tail != work_head) {
+            const work_item_t *item = &work_ring[work_tail & WORK_MASK];
+            work_func_t fn = item->fn;
+            void *arg = item->arg;
+
+            // Release the slot before running the item so it can re-queue.
+            work_tail = work_tail + 1U;
+            fn(arg);
+        }
+
+        uint32_t irq = irq_save();
+        if (work_tail == work_head) {
+            scheduler_block_current();
+        }
+        irq_restore(irq);
+    }
+}
+
+int workqueue_defer(work_func_t fn, void *arg)
+{
+    if (!fn) {
+        return -1;
+    }
+
+    uint32_t irq = irq_save();
+    uint32_t head = work_head;
+
+    if (head - work_tail >= KERNEL_WORKQUEUE_DEPTH) {
+        irq_restore(irq);
+        return -1;
+    }
+
+    work_ring[head & WORK_MASK].fn = fn;
+    work_ring[head & WORK_MASK].arg = arg;
+    work_head = head + 1U;
+
+    scheduler_wake(&work_tcb);
+
+    irq_restore(irq);
+    return 0;
+}